@@ -1,7 +1,10 @@
 ﻿#pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <span>
 #include "cond_check.hpp"
 
 namespace app_utils {
@@ -11,6 +14,15 @@ class circular_array_t {
   std::array<T, capacity_> m_array;
   size_t m_index = 0; // index ranges from 0 to 2 * capacity_ as a trick to handle wrap-around.
 
+  // a power of 2 capacity wraps indices around with a mask rather than a modulo
+  static constexpr size_t wrap(size_t const index) {
+    if constexpr (std::has_single_bit(capacity_)) {
+      return index & (capacity_ - 1);
+    } else {
+      return index % capacity_;
+    }
+  }
+
  public:
   static constexpr size_t capacity() { return capacity_; }
   constexpr bool empty() const { return m_index == 0; }
@@ -19,17 +31,17 @@ class circular_array_t {
 
   // get the oldest entry (if not empty)
   constexpr T const& front() const {
-    return m_array[m_index < capacity_ ? 0 : (m_index % capacity_)];
+    return m_array[m_index < capacity_ ? 0 : wrap(m_index)];
   }
 
   // get the most recent entry (if not empty)
   constexpr T const& back() const {
     checkCond(m_index > 0, "out of bound access");
-    return m_array[(m_index - 1) % capacity_];
+    return m_array[wrap(m_index - 1)];
   }
 
   constexpr T& get_next_slot() {
-    auto& next_slot = m_array[m_index % capacity_];
+    auto& next_slot = m_array[wrap(m_index)];
     ++m_index;
     if (m_index >= 2 * capacity_) {
       m_index = capacity_;
@@ -37,6 +49,32 @@ class circular_array_t {
     return next_slot;
   }
 
+  // same as writing each value to get_next_slot(), but copying the values in (up to) two contiguous segments
+  constexpr void push_back_range(std::span<T const> values) {
+    size_t const num_pushed = values.size();
+    // only the last capacity_ values remain
+    size_t const num_written = std::min(num_pushed, capacity_);
+    size_t const first_slot = wrap(m_index + num_pushed - num_written);
+    values = values.last(num_written);
+    size_t const first_size = std::min(num_written, capacity_ - first_slot);
+    std::copy_n(values.begin(), first_size, m_array.begin() + first_slot);
+    std::copy(values.begin() + first_size, values.end(), m_array.begin());
+
+    size_t const index = m_index + num_pushed;
+    m_index = index < capacity_ ? index : capacity_ + wrap(index);
+  }
+
+  // the content in logical order (oldest first), as (up to) two contiguous segments:
+  // the second one is empty unless the buffer wrapped around
+  constexpr std::array<std::span<T const>, 2> as_spans() const {
+    std::span<T const> const values = m_array;
+    if (m_index < capacity_) {
+      return {values.first(m_index), {}};
+    }
+    size_t const front_index = wrap(m_index);
+    return {values.subspan(front_index), values.first(front_index)};
+  }
+
   class iterator {
    public:
     constexpr iterator(circular_array_t& buffer, size_t state)
@@ -48,8 +86,8 @@ class circular_array_t {
       return *this;
     }
     constexpr bool operator!=(iterator const& other) const { return m_state != other.m_state; }
-    constexpr T const& operator*() const { return m_buffer.m_array[m_state % capacity_]; }
-    constexpr T& operator*() { return m_buffer.m_array[m_state % capacity_]; }
+    constexpr T const& operator*() const { return m_buffer.m_array[wrap(m_state)]; }
+    constexpr T& operator*() { return m_buffer.m_array[wrap(m_state)]; }
 
    private:
     circular_array_t& m_buffer;
@@ -67,7 +105,7 @@ class circular_array_t {
       return *this;
     }
     constexpr bool operator!=(const_iterator const& other) const { return m_state != other.m_state; }
-    constexpr T const& operator*() const { return m_buffer.m_array[m_state % capacity_]; }
+    constexpr T const& operator*() const { return m_buffer.m_array[wrap(m_state)]; }
 
   private:
     circular_array_t const& m_buffer;
@@ -2,14 +2,19 @@
 
 #include <vector>
 #include <span>
+#include <algorithm>
+#include <array>
 #include "cond_check.hpp"
+#include <bit>
 #include <cstddef>
 
 /**
  * a resizable circular buffer based on std::vector
+ * With power_of_two_capacity, the capacity must be a power of 2, and indices wrap around
+ * with a mask rather than with a modulo (i.e. an integer division, as the capacity is only known at runtime).
  */
 
-template<typename T>
+template<typename T, bool power_of_two_capacity = false>
 class circular_vector_t {
 
   size_t _capacity;
@@ -17,6 +22,21 @@ class circular_vector_t {
   size_t _back_index = 0;
   std::vector<T> _buffer;
 
+  [[nodiscard]]
+  size_t wrap(size_t index) const {
+    if constexpr (power_of_two_capacity) {
+      return index & (_capacity - 1);
+    } else {
+      return index % _capacity;
+    }
+  }
+
+  void check_capacity(size_t capacity) const {
+    if constexpr (power_of_two_capacity) {
+      checkCond(capacity == 0 or std::has_single_bit(capacity), "capacity must be a power of 2:", capacity);
+    }
+  }
+
 public:
 
   class Iterator {
@@ -77,6 +97,7 @@ public:
   using const_iterator = Iterator;
 
   circular_vector_t(size_t capacity=0) : _capacity(capacity){
+    check_capacity(capacity);
     _buffer.reserve(capacity);
   }
 
@@ -117,6 +138,20 @@ public:
     return _back_index < _front_index;
   }
 
+  // the content in logical order (oldest first), as (up to) two contiguous segments:
+  // the second one is empty unless the buffer wrapped around
+  [[nodiscard]]
+  std::array<std::span<T const>, 2> as_spans() const {
+    if (empty()) {
+      return {};
+    }
+    std::span<T const> const values = _buffer;
+    if (not has_wrapped_around()) {
+      return {values.subspan(_front_index, _back_index - _front_index + 1), {}};
+    }
+    return {values.subspan(_front_index), values.first(_back_index + 1)};
+  }
+
   [[nodiscard]]
   std::vector<T> const& as_vector(bool ignore_wrap_around) const {
     checkCond(ignore_wrap_around or not has_wrapped_around(), "circular vector cannot be interpreted as a vector once it started wrapping around");
@@ -153,6 +188,7 @@ public:
   }
 
   void reserve(size_t capacity) {
+    check_capacity(capacity);
     _capacity = capacity;
     _buffer.reserve(capacity);
   }
@@ -194,7 +230,7 @@ public:
   }
 
   T const& at(size_t index) const {
-    return _buffer.at((_front_index + index) % _capacity);
+    return _buffer.at(wrap(_front_index + index));
   }
 
   size_t distance_from(size_t index) const {
@@ -202,11 +238,11 @@ public:
   }
 
   T const& operator[](size_t index) const {
-    return _buffer[(_front_index + index) % _capacity];
+    return _buffer[wrap(_front_index + index)];
   }
 
   T& operator[](size_t index) {
-    return _buffer[(_front_index + index) % _capacity];
+    return _buffer[wrap(_front_index + index)];
   }
 
   template<typename U>
@@ -215,12 +251,12 @@ public:
       _buffer.push_back(std::forward<U>(value));
       _back_index = _buffer.size() - 1;
     } else {
-      _back_index = (_back_index + 1) % _capacity;
+      _back_index = wrap(_back_index + 1);
       _buffer[_back_index] = std::forward<U>(value);
       if (_front_index == _back_index) {
         // the new element is taking the place of the oldest element
         // so we push front index forward.
-        _front_index = (_back_index + 1) % _capacity;
+        _front_index = wrap(_back_index + 1);
       }
     }
   }
@@ -246,13 +282,40 @@ public:
   }
 
   void pop_front(size_t N = 1) {
-    for (size_t i = 0; i < N; i++) {
-      if (_front_index != _back_index) {
-        _front_index = (_front_index + 1) % _capacity;
-      } else {
-        clear();
-        break;
-      }
+    if (N >= size()) {
+      clear();
+    } else {
+      _front_index = wrap(_front_index + N);
+    }
+  }
+
+  // same as calling push_back for each value, but copying the values in (up to) two contiguous segments
+  void push_back_range(std::span<T const> values) {
+    // fill up to capacity first
+    size_t const num_appended = std::min(values.size(), _capacity - _buffer.size());
+    if (num_appended > 0) {
+      _buffer.insert(_buffer.end(), values.begin(), values.begin() + num_appended);
+      _back_index = _buffer.size() - 1;
+      values = values.subspan(num_appended);
+    }
+    if (values.empty()) {
+      return;
+    }
+
+    // then overwrite the oldest elements: only the last _capacity values remain
+    size_t const num_pushed = values.size();
+    size_t const num_written = std::min(num_pushed, _capacity);
+    // number of pushes before the oldest element gets overwritten
+    size_t const num_pushes_to_front = wrap(_front_index + _capacity - wrap(_back_index + 1)) + 1;
+    size_t const first_slot = wrap(_back_index + 1 + (num_pushed - num_written));
+    values = values.last(num_written);
+    size_t const first_size = std::min(num_written, _capacity - first_slot);
+    std::copy_n(values.begin(), first_size, _buffer.begin() + first_slot);
+    std::copy(values.begin() + first_size, values.end(), _buffer.begin());
+
+    _back_index = wrap(first_slot + num_written - 1);
+    if (num_pushed >= num_pushes_to_front) {
+      _front_index = wrap(_back_index + 1);
     }
   }
 };
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <version>
+#ifdef __cpp_lib_jthread
+#include <stop_token>
+#else
+#include "stop_token.hpp"
+#endif
+
+/**
+ * a bounded multi-producer / multi-consumer queue, lock-free and based on a circular buffer
+ * (D. Vyukov's algorithm: each slot holds a sequence number telling whether it is ready to be written or read,
+ * so that producers and consumers only contend on their own position counter).
+ * The capacity is rounded up to a power of 2.
+ * Blocking and timed variants spin, then yield, then sleep, and give up as soon as a stop is requested
+ * on the stop_token, so that shutting down doesn't hang on a full or empty queue.
+ */
+
+template<typename T>
+class mpmc_circular_vector_t {
+
+  static constexpr size_t cache_line_size = 64;
+
+  struct slot_t {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  size_t _capacity;
+  size_t _index_mask;
+  std::unique_ptr<slot_t[]> _slots;
+  alignas(cache_line_size) std::atomic<size_t> _push_index{0};
+  alignas(cache_line_size) std::atomic<size_t> _pop_index{0};
+
+  // retries attempt() until it succeeds, the deadline is reached or a stop is requested
+  template<typename Func>
+  static bool retry_until(Func&& attempt, std::chrono::steady_clock::time_point const deadline,
+                          std::stop_token const& stop_token) {
+    for (size_t num_attempts = 0; not attempt(); num_attempts++) {
+      if (stop_token.stop_requested()) {
+        return false;
+      }
+      if (num_attempts >= 64) {
+        if (deadline != std::chrono::steady_clock::time_point::max() and
+            std::chrono::steady_clock::now() >= deadline) {
+          return false;
+        }
+        if (num_attempts >= 1024) {
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+    return true;
+  }
+
+public:
+
+  explicit mpmc_circular_vector_t(size_t capacity)
+      : _capacity(std::bit_ceil(std::max<size_t>(capacity, 2)))
+      , _index_mask(_capacity - 1)
+      , _slots(new slot_t[_capacity]) {
+    for (size_t i = 0; i < _capacity; i++) {
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_circular_vector_t(mpmc_circular_vector_t const&) = delete;
+  mpmc_circular_vector_t& operator=(mpmc_circular_vector_t const&) = delete;
+
+  [[nodiscard]]
+  size_t capacity() const {
+    return _capacity;
+  }
+
+  // approximate when called while other threads are pushing or popping
+  [[nodiscard]]
+  size_t size() const {
+    size_t const pop_index = _pop_index.load(std::memory_order_acquire);
+    size_t const push_index = _push_index.load(std::memory_order_acquire);
+    return push_index > pop_index ? push_index - pop_index : 0;
+  }
+
+  [[nodiscard]]
+  bool empty() const {
+    return size() == 0;
+  }
+
+  // returns false if the queue is full. value is left untouched in that case
+  template<typename U>
+  bool try_push(U&& value) {
+    size_t index = _push_index.load(std::memory_order_relaxed);
+    slot_t* slot;
+    while (true) {
+      slot = &_slots[index & _index_mask];
+      size_t const sequence = slot->sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(index);
+      if (diff == 0) {
+        // the slot is free: claim it
+        if (_push_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // the slot still holds the value pushed one lap ago
+        return false;
+      } else {
+        // another producer claimed the slot
+        index = _push_index.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::forward<U>(value);
+    slot->sequence.store(index + 1, std::memory_order_release);
+    return true;
+  }
+
+  // returns false if the queue is empty
+  bool try_pop(T& value) {
+    size_t index = _pop_index.load(std::memory_order_relaxed);
+    slot_t* slot;
+    while (true) {
+      slot = &_slots[index & _index_mask];
+      size_t const sequence = slot->sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(index + 1);
+      if (diff == 0) {
+        // the slot holds a value: claim it
+        if (_pop_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // nothing pushed in that slot yet
+        return false;
+      } else {
+        // another consumer claimed the slot
+        index = _pop_index.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(slot->value);
+    // the slot is free for the push of the next lap
+    slot->sequence.store(index + _capacity, std::memory_order_release);
+    return true;
+  }
+
+  // blocks until the value is pushed. returns false if a stop got requested first
+  template<typename U>
+  bool push(U&& value, std::stop_token const& stop_token = {}) {
+    return retry_until([&] { return try_push(std::forward<U>(value)); },
+                       std::chrono::steady_clock::time_point::max(), stop_token);
+  }
+
+  // blocks until a value is popped. returns false if a stop got requested first
+  bool pop(T& value, std::stop_token const& stop_token = {}) {
+    return retry_until([&] { return try_pop(value); },
+                       std::chrono::steady_clock::time_point::max(), stop_token);
+  }
+
+  // returns false if the value couldn't be pushed before the deadline or a stop got requested
+  template<typename U>
+  bool try_push_until(U&& value, std::chrono::steady_clock::time_point const deadline,
+                      std::stop_token const& stop_token = {}) {
+    return retry_until([&] { return try_push(std::forward<U>(value)); }, deadline, stop_token);
+  }
+
+  template<typename U, typename Rep, typename Period>
+  bool try_push_for(U&& value, std::chrono::duration<Rep, Period> const& timeout,
+                    std::stop_token const& stop_token = {}) {
+    return try_push_until(std::forward<U>(value),
+                          std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(timeout),
+                          stop_token);
+  }
+
+  // returns false if no value could be popped before the deadline or a stop got requested
+  bool try_pop_until(T& value, std::chrono::steady_clock::time_point const deadline,
+                     std::stop_token const& stop_token = {}) {
+    return retry_until([&] { return try_pop(value); }, deadline, stop_token);
+  }
+
+  template<typename Rep, typename Period>
+  bool try_pop_for(T& value, std::chrono::duration<Rep, Period> const& timeout,
+                   std::stop_token const& stop_token = {}) {
+    return try_pop_until(value,
+                         std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(timeout),
+                         stop_token);
+  }
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <cstddef> // std::byte
+#include <cstdint>
+#include <cstring> // std::memcpy
 #include <utility>
 #include "reflexio_field_descriptor.hpp"
 #include "reflexio_iterator.hpp"
@@ -11,6 +14,8 @@
 
 #ifndef REFLEXIO_MINIMAL_FEATURES
 #include "reflexio_utils.hpp"
+#include "yaml_writer.hpp"
+#include "yaml_parser.hpp"
 #include <stdexcept>
 #endif
 
@@ -27,6 +32,28 @@ class CorruptedDeserializationException : public DeserializationException {
 };
 #endif
 
+namespace details {
+// (member variable name, index) pairs sorted by name, computed at compile time
+template <typename ReflexioStruct>
+struct sorted_field_names_t {
+  static constexpr size_t num_fields = ReflexioStruct::NumMemberVars;
+
+  static constexpr std::array<std::pair<std::string_view, size_t>, num_fields> names = [] {
+    std::array<std::pair<std::string_view, size_t>, num_fields> res{};
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      res[Field::index] = {Field::descriptor_impl->get_name(), Field::index};
+    });
+    std::sort(res.begin(), res.end());
+    return res;
+  }();
+
+  static_assert(std::adjacent_find(names.begin(), names.end(),
+                                   [](auto const& a, auto const& b) { return a.first == b.first; })
+                        == names.end(),
+                "duplicate member variable name");
+};
+}  // namespace details
+
 template <typename ReflexioStruct, size_t NumMemberVariables>
 struct ReflexioStructBase {
   using ReflexioTypeName = ReflexioStruct;
@@ -52,6 +79,55 @@ struct ReflexioStructBase {
   using ConstView = reflexio_view<ReflexioStruct const>;
   using FatView = reflexio_fat_view<ReflexioStruct>;
 
+  /**
+   * Calls func(field) for each member variable, in declaration order.
+   * The expansion happens at compile time: field is an instance of the member variable traits type,
+   * which exposes:
+   *  - member_type: the actual type of the member variable
+   *  - member_var_ptr: the pointer to member
+   *  - index: the position of the member variable in the descriptors list
+   *  - descriptor / descriptor_impl: the type-erased and the concrete member descriptor
+   * so that operations on the member variable are statically dispatched and can be inlined.
+   * If func returns a bool, the iteration stops at the first false value.
+   */
+  template<typename Func>
+  static constexpr void for_each_field(Func&& func) {
+    [&func]<size_t... I>(std::index_sequence<I...>) {
+      if constexpr ((std::is_void_v<decltype(func(typename ReflexioStruct::template member_var_traits_t<I, int>{}))> and ...)) {
+        (func(typename ReflexioStruct::template member_var_traits_t<I, int>{}), ...);
+      } else {
+        (bool(func(typename ReflexioStruct::template member_var_traits_t<I, int>{})) and ...);
+      }
+    }(std::make_index_sequence<NumMemberVariables>());
+  }
+
+  // index of the member variable called name, NumMemberVars if there is none.
+  // A binary search in a table sorted at compile time
+  static constexpr size_t find_field(std::string_view const name) {
+    auto const& names = details::sorted_field_names_t<ReflexioStruct>::names;
+    auto const it = std::lower_bound(names.begin(), names.end(), name,
+                                     [](auto const& entry, std::string_view const val) { return entry.first < val; });
+    return it != names.end() and it->first == name ? it->second : NumMemberVariables;
+  }
+
+  // Calls func(field, value) for each member variable, where value is a reference to the member variable
+  // and field is as described in for_each_field.
+  template<typename Func>
+  constexpr void visit_fields(Func&& func) const {
+    auto const& self = static_cast<ReflexioStruct const&>(*this);
+    for_each_field([&]<typename Field>(Field field) {
+      return func(field, self.*Field::member_var_ptr);
+    });
+  }
+
+  template<typename Func>
+  constexpr void visit_fields(Func&& func) {
+    auto& self = static_cast<ReflexioStruct&>(*this);
+    for_each_field([&]<typename Field>(Field field) {
+      return func(field, self.*Field::member_var_ptr);
+    });
+  }
+
   // same as:
   // offsetof(ReflexioStruct, member);
   // but can be called in a programmatic way.
@@ -69,21 +145,59 @@ struct ReflexioStructBase {
     return offsets;
   }
 
+  // true when the serial representation of the struct is a plain copy of its in-memory representation:
+  // every member variable is memcpy serializable and there is no padding nor unregistered member.
+  static constexpr bool has_packed_layout() {
+    if constexpr (std::is_standard_layout_v<ReflexioStruct> and std::is_trivially_copyable_v<ReflexioStruct>) {
+      return all_members_memcpy_serializable() and []<size_t... I>(std::index_sequence<I...>) {
+        return (sizeof(typename ReflexioStruct::template member_var_traits_t<I, int>::member_type) + ... + 0) == sizeof(ReflexioStruct);
+      }(std::make_index_sequence<NumMemberVariables>());
+    } else {
+      return false;
+    }
+  }
+
+  // true when every member variable gets serialized as a plain copy of its in-memory representation
+  static constexpr bool all_members_memcpy_serializable() {
+    return []<size_t... I>(std::index_sequence<I...>) {
+      using namespace app_utils::serial;
+      return (is_memcpy_serializable<typename ReflexioStruct::template member_var_traits_t<I, int>::member_type>::value and ...);
+    }(std::make_index_sequence<NumMemberVariables>());
+  }
+
+  // Index of the member variable in the descriptors list (NumMemberVars if not registered).
+  // Resolved by comparing pointers to member of the same type, so it gets constant folded
+  // when varPtr is known at compile time.
   template <typename T2>
-  static size_t index_of_var(T2 ReflexioStruct::* const varPtr) {
-    // do not use static as it leads to extra code size in embedded setting (gcc)
-    //static const auto member_var_offsets = get_member_var_offsets();
-    size_t offset = offset_of(varPtr);
-    for (size_t i = 0; i < NumMemberVariables; i++) {
-      if (ReflexioStruct::s_member_var_register[i]->get_var_offset() == offset) {
-        return i;
+  static constexpr size_t find_index_of_var(T2 ReflexioStruct::* const varPtr) {
+    size_t index = NumMemberVariables;
+    for_each_field([&]<typename Field>(Field) {
+      if constexpr (std::is_same_v<typename Field::member_type, T2>) {
+        if (Field::member_var_ptr == varPtr) {
+          index = Field::index;
+          return false;
+        }
       }
-    }
-    return 0; // should never get there - how to enforce it during compilation?
+      return true;
+    });
+    return index;
+  }
+
+  template <typename T2>
+  static constexpr size_t index_of_var(T2 ReflexioStruct::* const varPtr) {
+    size_t const index = find_index_of_var(varPtr);
+    return index < NumMemberVariables ? index : 0; // unregistered member variable: use the template version to catch it at compile time
+  }
+
+  template <auto VarPtr>
+  static consteval size_t index_of_var() {
+    constexpr size_t index = find_index_of_var(VarPtr);
+    static_assert(index < NumMemberVariables, "not a registered member variable");
+    return index;
   }
 
   template <typename Arg, typename... Args>
-  static /*consteval*/ bool strictly_increasing(Arg const& arg0, Args const&... args) {
+  static constexpr bool strictly_increasing(Arg const& arg0, Args const&... args) {
     if constexpr (sizeof...(args) == 0) {
       (void) arg0; // avoid unreferenced formal parameter compiler warning
       return true;
@@ -96,13 +210,27 @@ struct ReflexioStructBase {
   template<typename ...VarPtrs>
     requires(sizeof...(VarPtrs) <= NumMemberVariables)
   constexpr static Mask make_vars_mask(VarPtrs const& ... varPtrs) {
-    // strictly_increasing can't be called in a constexpr context (because of index_of_var)
-    //static_assert(strictly_increasing(varPtrs...));
+    // function arguments can't be checked with a static_assert: see the template version below
     Mask include_mask;
     (include_mask.set(index_of_var(varPtrs)), ...);
     return include_mask.flip();
   }
 
+  // same as above with the mask computed at compile time, e.g. make_vars_mask<&S::var1, &S::var3>()
+  template<auto ...VarPtrs>
+    requires(0 < sizeof...(VarPtrs) and sizeof...(VarPtrs) <= NumMemberVariables)
+  constexpr static Mask make_vars_mask() {
+    static_assert(strictly_increasing(VarPtrs...), "member variables should be listed in declaration order");
+    if constexpr (NumMemberVariables <= 64) {
+      // only the bitset integer constructor is constexpr
+      return Mask{~((1ull << index_of_var<VarPtrs>()) | ... | 0ull)};
+    } else {
+      Mask include_mask;
+      (include_mask.set(index_of_var<VarPtrs>()), ...);
+      return include_mask.flip();
+    }
+  }
+
   struct MembersDescriptorView {
     Mask const& m_excludeMask;
     constexpr MembersDescriptorView(Mask const& excludeMask)
@@ -130,12 +258,11 @@ struct ReflexioStructBase {
 #ifndef REFLEXIO_NO_COMPARISON_OPERATORS
   [[nodiscard]]
   friend constexpr bool operator==(ReflexioStruct const& self, ReflexioStruct const& other) {
-    for (auto& descriptor : self.get_member_descriptors()) {
-      if (descriptor->values_differ(&self, &other)) {
-        return false;
-      }
-    }
-    return true;
+    bool equal = true;
+    for_each_field([&]<typename Field>(Field) {
+      return equal = not Field::descriptor_impl->values_differ(&self, &other);
+    });
+    return equal;
   }
 
   [[nodiscard]]
@@ -153,19 +280,20 @@ struct ReflexioStructBase {
   constexpr bool has_all_default_values(
           Mask const& excludeMask=exclude_none) const
   {
-    for (auto& descriptor: get_member_descriptors(excludeMask)) {
-      if (not descriptor.is_at_default(this)) {
-        return false;
-      }
-    }
-    return true;
+    bool at_default = true;
+    for_each_field([&]<typename Field>(Field) {
+      return at_default = excludeMask[Field::index] or Field::descriptor_impl->is_at_default(this);
+    });
+    return at_default;
   }
 
   constexpr void set_to_default(
           Mask const& excludeMask=exclude_none) {
-    for (auto& descriptor: get_member_descriptors(excludeMask)) {
-      descriptor.set_to_default(this);
-    }
+    for_each_field([&]<typename Field>(Field) {
+      if (not excludeMask[Field::index]) {
+        Field::descriptor_impl->set_to_default(this);
+      }
+    });
   }
 
   [[nodiscard]]
@@ -173,11 +301,11 @@ struct ReflexioStructBase {
           Mask const& excludeMask=exclude_none) const
   {
     std::vector<std::string_view> res;
-    for (auto& descriptor: get_member_descriptors(excludeMask)) {
-      if (not descriptor.is_at_default(this)) {
-        res.push_back(descriptor.get_name());
+    for_each_field([&]<typename Field>(Field) {
+      if (not excludeMask[Field::index] and not Field::descriptor_impl->is_at_default(this)) {
+        res.push_back(Field::descriptor_impl->get_name());
       }
-    }
+    });
     return res;
   }
 
@@ -192,13 +320,11 @@ struct ReflexioStructBase {
                        Mask const& excludeMask=exclude_none) const {
     Mask res;
     res.flip();
-
-    auto descriptor_view = get_member_descriptors(excludeMask);
-    for (auto it = descriptor_view.begin(); it != descriptor_view.end(); it++) {
-      if (it->values_differ(this, &other)) {
-        res.set(it.m_idx, false);
+    for_each_field([&]<typename Field>(Field) {
+      if (not excludeMask[Field::index] and Field::descriptor_impl->values_differ(this, &other)) {
+        res.set(Field::index, false);
       }
-    }
+    });
     return res;
   }
 
@@ -208,11 +334,11 @@ struct ReflexioStructBase {
           Mask const& excludeMask=exclude_none) const
   {
     std::vector<std::string_view> res;
-    for (auto& descriptor: get_member_descriptors(excludeMask)) {
-      if (descriptor.values_differ(this, &other)) {
-        res.push_back(descriptor.get_name());
+    for_each_field([&]<typename Field>(Field) {
+      if (not excludeMask[Field::index] and Field::descriptor_impl->values_differ(this, &other)) {
+        res.push_back(Field::descriptor_impl->get_name());
       }
-    }
+    });
     return res;
   }
 
@@ -250,12 +376,52 @@ struct ReflexioStructBase {
     return os;
   }
 
+  // formats straight into the writer buffer, with no virtual call per member variable
+  friend void write_yaml(
+          yaml_utils::yaml_writer& writer,
+          ConstView const& view) {
+    auto const nested_scope = writer.enter_nested();
+    bool const am_i_nested = writer.depth() > 0;
+    if (am_i_nested) {
+      writer.append('\n');
+    }
+
+    size_t const last_index = NumMemberVariables - 1;
+    size_t field_index = 0;
+    for_each_field([&]<typename Field>(Field) {
+      if (not view.exclude_mask[Field::index]) {
+        writer.indent();
+        writer.append(Field::descriptor_impl->get_name()).append(": ");
+        writer.write(view.object.*Field::member_var_ptr);
+        // except after the last field of a nested struct, as the enclosing struct ends the line
+        if (field_index < last_index or not am_i_nested) {
+          writer.append('\n');
+        }
+        field_index++;
+      }
+    });
+  }
+
+  friend void write_yaml(
+          yaml_utils::yaml_writer& writer,
+          ReflexioStruct const& obj) {
+    write_yaml(writer, ConstView{obj});
+  }
+
+  // appends to out, which can be reused across calls to avoid allocations
+  friend void to_yaml(
+          ConstView const& view,
+          std::string& out) {
+    yaml_utils::yaml_writer writer(out);
+    write_yaml(writer, view);
+  }
+
   [[nodiscard]]
   friend std::string to_yaml(
         ConstView const& instance) {
-    std::ostringstream oss;
-    oss << instance;
-    return oss.str();
+    std::string res;
+    to_yaml(instance, res);
+    return res;
   }
 
   [[nodiscard]]
@@ -284,12 +450,87 @@ struct ReflexioStructBase {
     return from_yaml(instance.object, is, instance.exclude_mask);
   }
 
+  /**
+   * Single pass parsing of in-memory yaml: member variables are found through a lookup table built once per struct type,
+   * and values are parsed with yaml_utils::parse_value, straight from the text.
+   * Stops at the end of the section ('---' or '...'), or at the first line indented less than the first one,
+   * which is left to the reader for the caller.
+   */
+  friend void from_yaml(
+          ReflexioStruct& instance,
+          yaml_utils::yaml_reader& reader,
+          Mask const& exclude_mask=exclude_none) {
+    bool first_line_seen = false;
+    size_t start_indent = 0;
+    yaml_utils::yaml_line_t line;
+    while (reader.peek(line)) {
+      if (line.content.empty() or line.content.starts_with('#')) {
+        reader.consume(line);
+        continue;
+      } else if (line.content == "---") {
+        reader.consume(line);
+        if (first_line_seen) {
+          // signals the start of another section
+          break;
+        }
+        checkCond(line.indent == 0);
+        continue;
+      } else if (line.content == "...") {
+        // end of section
+        reader.consume(line);
+        break;
+      } else if (not first_line_seen) {
+        start_indent = line.indent;
+      } else if (start_indent > line.indent) {
+        break;
+      }
+      first_line_seen = true;
+      reader.consume(line);
+
+      size_t const separator_pos = line.content.find(':');
+      checkCond(separator_pos != std::string_view::npos,
+                "cannot parse a 'name: value' pair at line", line.line_num, ':', line.raw);
+      auto const name = line.content.substr(0, separator_pos);
+      auto val = line.content.substr(separator_pos + 1);
+      val = app_utils::strutils::strip(val.substr(0, val.find('#')));
+
+      size_t const index = find_field(name);
+      checkCond(index != NumMemberVariables, "unrecognized",
+                "member name", name, "at line", line.line_num, ':', line.raw);
+
+      if (exclude_mask.test(index)) {
+        // skip the value, and its nested lines
+        yaml_utils::yaml_line_t nested_line;
+        while (reader.peek(nested_line) and (nested_line.content.empty() or nested_line.indent > line.indent)) {
+          reader.consume(nested_line);
+        }
+        continue;
+      }
+
+      for_each_field([&]<typename Field>(Field) {
+        if (Field::index != index) {
+          return true;
+        }
+        auto& member = instance.*Field::member_var_ptr;
+        if constexpr (requires { from_yaml(member, reader); }) {
+          // nested reflexio struct
+          checkCond(val.empty(), "unexpected value for", name, "at line", line.line_num, ':', line.raw);
+          from_yaml(member, reader);
+        } else {
+          checkCond(yaml_utils::parse_value(member, val),
+                    "Failed parsing line", line.line_num, ":", line.raw);
+        }
+        return false;
+      });
+    }
+  }
+
   friend void from_yaml(
           ReflexioStruct& instance,
           std::string_view const val_str,
           Mask const& exclude_mask=exclude_none) {
-    std::istringstream iss (std::string{val_str});
-    from_yaml(instance, iss, exclude_mask);
+    yaml_utils::yaml_reader reader(val_str);
+    from_yaml(instance, reader, exclude_mask);
   }
 
   friend void from_yaml(
@@ -346,18 +587,35 @@ struct ReflexioStructBase {
   [[nodiscard]]
   static constexpr size_t get_serial_size(Mask const& excludeMask) {
     size_t res = 0;
-    for (auto& descriptor: ReflexioStruct::get_member_descriptors(excludeMask)) {
-      res += descriptor.get_serial_size();
-    }
+    for_each_field([&]<typename Field>(Field) {
+      if (not excludeMask[Field::index]) {
+        res += Field::descriptor_impl->get_serial_size();
+      }
+    });
     return res;
   }
 
   [[nodiscard]]
   static constexpr size_t get_serial_size() {
     size_t res = 0;
-    for (auto& descriptor: ReflexioStruct::get_member_descriptors()) {
-      res += descriptor->get_serial_size();
-    }
+    for_each_field([&]<typename Field>(Field) {
+      res += Field::descriptor_impl->get_serial_size();
+    });
+    return res;
+  }
+
+  // offset of the member variable at Index within the serial representation of the whole struct
+  template<size_t Index>
+    requires(Index <= NumMemberVariables)
+  static constexpr size_t get_serial_offset() {
+    size_t res = 0;
+    for_each_field([&]<typename Field>(Field) {
+      if (Field::index >= Index) {
+        return false;
+      }
+      res += Field::descriptor_impl->get_serial_size();
+      return true;
+    });
     return res;
   }
 
@@ -366,6 +624,9 @@ struct ReflexioStructBase {
                          size_t const buffer_size,
                          ReflexioStruct const& instance,
                          Mask const& excludeMask=exclude_none) {
+    if (excludeMask.none()) {
+      return ReflexioStruct::all_fields_to_bytes(buffer, buffer_size, instance);
+    }
     size_t res = 0;
     for (auto& descriptor: ReflexioStruct::get_member_descriptors(excludeMask)) {
       //std::cout << "    encoded " << descriptor.get_name() << std::endl;
@@ -387,25 +648,16 @@ struct ReflexioStructBase {
                            size_t const buffer_size,
                            ReflexioStruct& instance,
                            Mask const& excludeMask=exclude_none) {
-
+    if (excludeMask.none()) {
+      return ReflexioStruct::all_fields_from_bytes(buffer, buffer_size, instance);
+    }
     size_t res = 0;
     for (auto& descriptor: ReflexioStruct::get_member_descriptors(excludeMask)) {
-      if (buffer_size <= res) {
-#ifdef RTTI_ENABLED
-        throwWithTrace(PartialDeserializationException,
-                       descriptor.get_name(), ": no data left for deserialization of", app_utils::typeName<ReflexioStruct>());
-#else
+      if (not has_bytes_left(descriptor, buffer_size, res)) {
         return res;
-#endif
       }
-
       res += descriptor.read_from_bytes(buffer + res, buffer_size - res, &instance);
-#ifdef RTTI_ENABLED
-      if (buffer_size < res) {
-        throwWithTrace(CorruptedDeserializationException, descriptor.get_name(), ": not enough data for deserialization of",
-                  app_utils::typeName<ReflexioStruct>(), "required", res, "bytes, found", buffer_size);
-      }
-#endif
+      check_no_overrun(descriptor, buffer_size, res);
     }
 
     return res;
@@ -416,9 +668,163 @@ struct ReflexioStructBase {
                            Mask const& excludeMask=exclude_none) {
     return from_bytes(buffer.data(), buffer.size(), instance, excludeMask);
   }
+
+  /**
+   * Serialization of consecutive records back to back, i.e. the same bytes as calling to_bytes on each of them,
+   * with a single size check and no per record dispatch:
+   *  - packed layouts: a single memcpy
+   *  - member variables all memcpy serializable: one strided copy per member variable
+   *  - otherwise: statically dispatched to_bytes calls
+   * returns the number of written bytes
+   */
+  friend size_t to_bytes_batch(std::byte* buffer,
+                               size_t const buffer_size,
+                               std::span<ReflexioStruct const> const instances) {
+    constexpr size_t record_size = ReflexioStruct::get_serial_size();
+    size_t const num_bytes = record_size * instances.size();
+    checkCond(buffer_size >= num_bytes, "output buffer is not big enough to accommodate objects", buffer_size, '<', num_bytes);
+    if constexpr (has_packed_layout()) {
+      std::memcpy(buffer, instances.data(), num_bytes);
+    } else if constexpr (all_members_memcpy_serializable()) {
+      for_each_field([&]<typename Field>(Field) {
+        constexpr size_t offset = ReflexioStruct::template get_serial_offset<Field::index>();
+        constexpr size_t field_size = sizeof(typename Field::member_type);
+        for (size_t i = 0; i < instances.size(); i++) {
+          std::memcpy(buffer + i * record_size + offset, &(instances[i].*Field::member_var_ptr), field_size);
+        }
+      });
+    } else {
+      using namespace app_utils::serial;
+      size_t res = 0;
+      for (auto const& instance : instances) {
+        for_each_field([&]<typename Field>(Field) {
+          res += to_bytes(buffer + res, buffer_size - res, instance.*Field::member_var_ptr);
+        });
+      }
+    }
+    return num_bytes;
+  }
+
+  // deserialization of instances.size() records serialized back to back, returns the number of read bytes
+  friend size_t from_bytes_batch(std::byte const* buffer,
+                                 size_t const buffer_size,
+                                 std::span<ReflexioStruct> const instances) {
+    constexpr size_t record_size = ReflexioStruct::get_serial_size();
+    size_t const num_bytes = record_size * instances.size();
+    if (buffer_size < num_bytes) {
+#ifdef RTTI_ENABLED
+      throwWithTrace(PartialDeserializationException, "not enough data for deserialization of", instances.size(),
+                     app_utils::typeName<ReflexioStruct>(), "required", num_bytes, "bytes, found", buffer_size);
+#else
+      return 0;
+#endif
+    }
+    if constexpr (has_packed_layout()) {
+      std::memcpy(instances.data(), buffer, num_bytes);
+    } else if constexpr (all_members_memcpy_serializable()) {
+      for_each_field([&]<typename Field>(Field) {
+        constexpr size_t offset = ReflexioStruct::template get_serial_offset<Field::index>();
+        constexpr size_t field_size = sizeof(typename Field::member_type);
+        for (size_t i = 0; i < instances.size(); i++) {
+          std::memcpy(&(instances[i].*Field::member_var_ptr), buffer + i * record_size + offset, field_size);
+        }
+      });
+    } else {
+      using namespace app_utils::serial;
+      size_t res = 0;
+      for (auto& instance : instances) {
+        for_each_field([&]<typename Field>(Field) {
+          res += from_bytes(buffer + res, buffer_size - res, instance.*Field::member_var_ptr);
+        });
+      }
+    }
+    return num_bytes;
+  }
+
+ private:
+  // Serialization of all the member variables, with no virtual call nor mask test per field:
+  // either a single memcpy for packed layouts, or a sequence of statically dispatched to_bytes calls.
+  static size_t all_fields_to_bytes(std::byte* buffer,
+                                    size_t const buffer_size,
+                                    ReflexioStruct const& instance) {
+    if constexpr (has_packed_layout()) {
+      constexpr size_t num_bytes = sizeof(ReflexioStruct);
+      checkCond(buffer_size >= num_bytes, "output buffer is not big enough to accommodate object", buffer_size, '<', num_bytes);
+      std::memcpy(buffer, &instance, num_bytes);
+      return num_bytes;
+    } else {
+      size_t res = 0;
+      for_each_field([&]<typename Field>(Field) {
+        using namespace app_utils::serial;
+        res += to_bytes(buffer + res, buffer_size - res, instance.*Field::member_var_ptr);
+      });
+      checkCond(buffer_size >= res, "output buffer is not big enough to accommodate object", buffer_size, '<', res);
+      return res;
+    }
+  }
+
+  static size_t all_fields_from_bytes(std::byte const* buffer,
+                                      size_t const buffer_size,
+                                      ReflexioStruct& instance) {
+    if constexpr (has_packed_layout()) {
+      if (buffer_size >= sizeof(ReflexioStruct)) {
+        std::memcpy(&instance, buffer, sizeof(ReflexioStruct));
+        return sizeof(ReflexioStruct);
+      }
+      // otherwise fall through to the field by field deserialization,
+      // which deals with partial data.
+    }
+    size_t res = 0;
+    for_each_field([&]<typename Field>(Field) {
+      if (not has_bytes_left(*Field::descriptor, buffer_size, res)) {
+        return false;
+      }
+      using namespace app_utils::serial;
+      res += from_bytes(buffer + res, buffer_size - res, instance.*Field::member_var_ptr);
+      check_no_overrun(*Field::descriptor, buffer_size, res);
+      return true;
+    });
+    return res;
+  }
+
+  // returns false if there is no data left for deserializing the member variable (when exceptions are not available)
+  static bool has_bytes_left([[maybe_unused]] member_descriptor_t const& descriptor,
+                             size_t const buffer_size,
+                             size_t const num_bytes_read) {
+    if (buffer_size <= num_bytes_read) {
+#ifdef RTTI_ENABLED
+      throwWithTrace(PartialDeserializationException,
+                     descriptor.get_name(), ": no data left for deserialization of", app_utils::typeName<ReflexioStruct>());
+#else
+      return false;
+#endif
+    }
+    return true;
+  }
+
+  static void check_no_overrun([[maybe_unused]] member_descriptor_t const& descriptor,
+                               [[maybe_unused]] size_t const buffer_size,
+                               [[maybe_unused]] size_t const num_bytes_read) {
+#ifdef RTTI_ENABLED
+    if (buffer_size < num_bytes_read) {
+      throwWithTrace(CorruptedDeserializationException, descriptor.get_name(), ": not enough data for deserialization of",
+                     app_utils::typeName<ReflexioStruct>(), "required", num_bytes_read, "bytes, found", buffer_size);
+    }
+#endif
+  }
 };
 
 namespace details {
+// FNV-1a, for hashing field names and schema descriptions
+constexpr uint64_t fnv1a_hash(std::string_view const text,
+                              uint64_t hash = 0xcbf29ce484222325ull) {
+  for (char const c : text) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
 consteval size_t count_member_var_declarations(std::string_view const text) {
   size_t count = 0;
 
@@ -436,8 +842,18 @@ consteval size_t count_member_var_declarations(std::string_view const text) {
 template <typename T>
 using is_reflexio_struct = std::is_base_of<ReflexioStructBase<T, T::NumMemberVars>, T>;
 
+// unlike is_reflexio_struct, usable with any type, e.g. in if constexpr chains
+template <typename T>
+concept reflexio_struct = requires { T::NumMemberVars; } and is_reflexio_struct<T>::value;
+
 } // namespace reflexio
 
+// nested reflexio structs with a packed layout can be part of an enclosing struct bulk copy
+template <typename T>
+  requires reflexio::is_reflexio_struct<T>::value
+struct app_utils::serial::is_memcpy_serializable<T>
+    : std::bool_constant<T::has_packed_layout()> {};
+
 #define _REFLEXIO_MEMBER_VAR_DEFINE_BOUND_FUNC(var_type, var_name, default_value, description, boundMinFunc, boundMaxFunc) \
   var_type var_name = var_type(default_value);                                             \
   static constexpr int __##var_name##_id = __COUNTER__;                                    \
@@ -460,6 +876,10 @@ using is_reflexio_struct = std::is_base_of<ReflexioStructBase<T, T::NumMemberVar
                                                                                            \
   template<class Dummy>                                                                    \
   struct member_var_traits_t<member_var_counter_t<__##var_name##_id, int>::index, Dummy> { \
+    using member_type = var_type;                                                          \
+    static constexpr size_t index = member_var_counter_t<__##var_name##_id, int>::index;   \
+    static constexpr auto member_var_ptr = &ReflexioTypeName::var_name;                    \
+    static constexpr auto const* descriptor_impl = &__##var_name##_descr;                  \
     static constexpr                                                                       \
     reflexio::member_descriptor_t const* descriptor = &__##var_name##_descr;               \
   }
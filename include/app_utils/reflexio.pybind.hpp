@@ -82,22 +82,21 @@ struct pybind_wrapper<ReflexioStruct,
       .def("__len__", [](View const& view) { return view.exclude_mask.size() - view.exclude_mask.count(); },
            "return the number of populated (non-stale) fields")
       .def("__getitem__", [](View const& self_, std::string_view name) {
-        for (auto& member_descriptor : ReflexioStruct::get_member_descriptors(self_.exclude_mask)) {
-          if (name == member_descriptor.get_name()) {
-            return member_descriptor.get_py_value(&self_.object, pybind11::return_value_policy::reference);
-          }
+        size_t const index = ReflexioStruct::find_field(name);
+        if (index == ReflexioStruct::NumMemberVars or self_.exclude_mask.test(index)) {
+          throw py::key_error("key '" + std::string{name} + "' does not exist");
         }
-        throw py::key_error("key '" + std::string{name} + "' does not exist");
+        auto member_descriptor = ReflexioStruct::get_member_descriptors()[index];
+        return member_descriptor->get_py_value(&self_.object, pybind11::return_value_policy::reference);
       })
       .def("__setitem__",
            [](View& self_, std::string_view name, py::object const& value) {
-             for (auto& member_descriptor : ReflexioStruct::get_member_descriptors(self_.exclude_mask)) {
-               if (name == member_descriptor.get_name()) {
-                 member_descriptor.set_py_value(&self_.object, value);
-                 return;
-               }
+             size_t const index = ReflexioStruct::find_field(name);
+             if (index == ReflexioStruct::NumMemberVars or self_.exclude_mask.test(index)) {
+               throw py::key_error("key '" + std::string{name} + "' does not exist");
              }
-             throw py::key_error("key '" + std::string{name} + "' does not exist");
+             auto member_descriptor = ReflexioStruct::get_member_descriptors()[index];
+             member_descriptor->set_py_value(&self_.object, value);
            })
       ;
   }
@@ -133,22 +132,21 @@ struct pybind_wrapper<ReflexioStruct,
           //     [](ReflexioStruct const& self_) { return py::make_iterator(self_.begin(), self_.end()); },
           //     py::keep_alive<0, 1>())
           .def("__getitem__", [](ReflexioStruct const& self_, std::string_view name) {
-                  for (auto member_descriptor : ReflexioStruct::get_member_descriptors()) {
-                   if (name == member_descriptor->get_name()) {
-                     return member_descriptor->get_py_value(&self_, pybind11::return_value_policy::reference);
-                   }
+                 size_t const index = ReflexioStruct::find_field(name);
+                 if (index == ReflexioStruct::NumMemberVars) {
+                   throw py::key_error("key '" + std::string{name} + "' does not exist");
                  }
-                 throw py::key_error("key '" + std::string{name} + "' does not exist");
+                 auto member_descriptor = ReflexioStruct::get_member_descriptors()[index];
+                 return member_descriptor->get_py_value(&self_, pybind11::return_value_policy::reference);
           })
           .def("__setitem__",
                [](ReflexioStruct& self_, std::string_view name, py::object const& value) {
-                 for (auto member_descriptor : ReflexioStruct::get_member_descriptors()) {
-                   if (name == member_descriptor->get_name()) {
-                     member_descriptor->set_py_value(&self_, value);
-                     return;
-                   }
+                 size_t const index = ReflexioStruct::find_field(name);
+                 if (index == ReflexioStruct::NumMemberVars) {
+                   throw py::key_error("key '" + std::string{name} + "' does not exist");
                  }
-                 throw py::key_error("key '" + std::string{name} + "' does not exist");
+                 auto member_descriptor = ReflexioStruct::get_member_descriptors()[index];
+                 member_descriptor->set_py_value(&self_, value);
                })
          /**
           * getitem and setitem that take an index: required for numpy compatibility
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef> // std::byte
+#include "reflexio.hpp"
+
+/**
+ * Delta encoding of reflexio structs against a previous snapshot of the same struct:
+ *   - bitmap of the changed member variables (serial_size of the Mask, i.e. (NumMemberVars + 7) / 8 bytes)
+ *   - the changed member variables, in declaration order, as serialized by to_bytes.
+ * The receiver applies the delta on its copy of the previous snapshot.
+ */
+
+namespace reflexio {
+
+// size of the delta between prev and cur
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+size_t serial_size_delta(ReflexioStruct const& prev, ReflexioStruct const& cur) {
+  using namespace app_utils::serial;
+  auto const unchangedMask = cur.matching_fields(prev);
+  return serial_size(unchangedMask) + ReflexioStruct::get_serial_size(unchangedMask);
+}
+
+// returns the number of written bytes
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+size_t to_bytes_delta(std::byte* buffer,
+                      size_t const buffer_size,
+                      ReflexioStruct const& prev,
+                      ReflexioStruct const& cur) {
+  using namespace app_utils::serial;
+  auto const unchangedMask = cur.matching_fields(prev);
+  size_t const num_bytes = serial_size(unchangedMask) + ReflexioStruct::get_serial_size(unchangedMask);
+  checkCond(buffer_size >= num_bytes, "output buffer is not big enough to accommodate delta", buffer_size, '<', num_bytes);
+
+  size_t res = to_bytes(buffer, buffer_size, ~unchangedMask);
+  ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+    if (not unchangedMask[Field::index]) {
+      res += to_bytes(buffer + res, buffer_size - res, cur.*Field::member_var_ptr);
+    }
+  });
+  return res;
+}
+
+/**
+ * updates state (the previous snapshot) with the delta in buffer.
+ * returns the number of bytes read, or 0 (state left untouched) for a truncated delta
+ * in builds where checkCond doesn't throw (no RTTI)
+ */
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+size_t apply_delta(std::byte const* buffer,
+                   size_t const buffer_size,
+                   ReflexioStruct& state) {
+  using namespace app_utils::serial;
+  typename ReflexioStruct::Mask changedMask;
+  size_t const mask_size = serial_size(changedMask);
+  checkCond(buffer_size >= mask_size, "not enough data for the delta bitmap of", app_utils::typeName<ReflexioStruct>(),
+            "required", mask_size, "bytes, found", buffer_size);
+  if (buffer_size < mask_size) {
+    return 0;
+  }
+  size_t res = from_bytes(buffer, buffer_size, changedMask);
+
+  size_t const num_bytes = res + ReflexioStruct::get_serial_size(~changedMask);
+  checkCond(buffer_size >= num_bytes, "not enough data for the delta of", app_utils::typeName<ReflexioStruct>(),
+            "required", num_bytes, "bytes, found", buffer_size);
+  if (buffer_size < num_bytes) {
+    return 0;
+  }
+  ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+    if (changedMask[Field::index]) {
+      res += from_bytes(buffer + res, buffer_size - res, state.*Field::member_var_ptr);
+    }
+  });
+  return res;
+}
+
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+size_t apply_delta(std::span<std::byte const> buffer, ReflexioStruct& state) {
+  return apply_delta(buffer.data(), buffer.size(), state);
+}
+
+} // namespace reflexio
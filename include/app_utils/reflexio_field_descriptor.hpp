@@ -270,8 +270,8 @@ struct member_descriptor_impl_t final : public member_descriptor_t {
 #ifndef REFLEXIO_NO_COMPARISON_OPERATORS
   [[nodiscard]]
   constexpr bool values_differ(void const* host1, void const* host2) const final {
-    auto val1 = get_value(host1);
-    auto val2 = get_value(host2);
+    auto const& val1 = get_value(host1);
+    auto const& val2 = get_value(host2);
     // consider two nan values are equal
     if constexpr (details::has_nan_values<MemberType>{}) {
       using std::isnan;
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <cstddef> // std::byte
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "reflexio record files rely on mmap, which is only supported on POSIX platforms"
+#endif
+
+#include "reflexio.hpp"
+#include "reflexio_tagged.hpp"
+#include "reflexio_wire_view.hpp"
+
+/**
+ * File format for sequences of reflexio structs of the same type:
+ *   - a fixed size header, carrying the fingerprint of the struct schema
+ *   - the records, each serialized with to_bytes (all member variables included), back to back.
+ * Files get written by appending records to them, and get read back through a read-only memory mapping
+ * that gives random access to the records with no upfront loading.
+ */
+
+namespace reflexio {
+
+// hash of the member variables names and type structures, in declaration order.
+// Built from details::tagged_type_signature rather than from type names, so that it doesn't depend on the compiler
+template <typename ReflexioStruct>
+constexpr uint64_t schema_fingerprint() {
+  uint64_t hash = details::fnv1a_hash("");
+  ReflexioStruct::for_each_field([&hash]<typename Field>(Field) {
+    hash = details::fnv1a_hash(Field::descriptor_impl->get_name(), hash);
+    hash = details::tagged_type_signature<typename Field::member_type>(hash);
+  });
+  return hash;
+}
+
+namespace details {
+
+struct record_file_header_t {
+  static constexpr std::array<char, 8> s_magic = {'R', 'F', 'X', 'R', 'E', 'C', 'O', 'R'};
+  static constexpr uint32_t s_format_version = 2; // 2: compiler independent schema fingerprint
+  static constexpr size_t s_serial_size = s_magic.size() + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+  std::array<char, 8> magic = s_magic;
+  uint32_t format_version = s_format_version;
+  uint32_t record_size = 0;
+  uint64_t schema_fingerprint = 0;
+
+  template <typename ReflexioStruct>
+  static record_file_header_t make() {
+    record_file_header_t header;
+    header.record_size = static_cast<uint32_t>(ReflexioStruct::get_serial_size());
+    header.schema_fingerprint = reflexio::schema_fingerprint<ReflexioStruct>();
+    return header;
+  }
+
+  std::array<std::byte, s_serial_size> to_bytes() const {
+    std::array<std::byte, s_serial_size> buffer;
+    app_utils::serial::to_bytes(buffer.data(), buffer.size(), magic, format_version, record_size, schema_fingerprint);
+    return buffer;
+  }
+
+  static record_file_header_t from_bytes(std::span<std::byte const> bytes) {
+    checkCond(bytes.size() >= s_serial_size, "truncated record file header");
+    record_file_header_t header;
+    app_utils::serial::from_bytes(bytes.data(), bytes.size(),
+                                  header.magic, header.format_version, header.record_size, header.schema_fingerprint);
+    return header;
+  }
+
+  template <typename ReflexioStruct>
+  void check_compatible(std::filesystem::path const& file_path) const {
+    auto const expected = make<ReflexioStruct>();
+    checkCond(magic == s_magic, file_path, "is not a reflexio record file");
+    checkCond(format_version == expected.format_version, file_path,
+              "unsupported record file format version", format_version);
+    checkCond(record_size == expected.record_size and schema_fingerprint == expected.schema_fingerprint,
+              file_path, "schema mismatch for", app_utils::typeName<ReflexioStruct>(),
+              "record size:", record_size, "vs", expected.record_size);
+  }
+};
+}  // namespace details
+
+/**
+ * Appends records to a (new or existing) record file.
+ * A trailing partial record left in an existing file by an interrupted write gets truncated on opening.
+ */
+template <typename ReflexioStruct>
+class record_file_writer {
+  std::FILE* m_file = nullptr;
+
+ public:
+  explicit record_file_writer(std::filesystem::path const& file_path) {
+    using header_t = details::record_file_header_t;
+    std::error_code error;
+    bool const is_new_file = not std::filesystem::exists(file_path, error) or
+                             std::filesystem::file_size(file_path, error) == 0;
+    if (not is_new_file) {
+      std::FILE* file = std::fopen(file_path.c_str(), "rb");
+      checkCond(file != nullptr, "failed opening", file_path);
+      std::array<std::byte, header_t::s_serial_size> header_bytes;
+      size_t const num_read = std::fread(header_bytes.data(), 1, header_bytes.size(), file);
+      std::fclose(file);
+      header_t::from_bytes(std::span{header_bytes}.first(num_read)).template check_compatible<ReflexioStruct>(file_path);
+
+      // drop a trailing partial record (e.g. interrupted write), which would misalign the records appended after it
+      size_t const file_size = std::filesystem::file_size(file_path);
+      size_t const records_size = file_size - header_t::s_serial_size;
+      size_t const partial_record_size = records_size % ReflexioStruct::get_serial_size();
+      if (partial_record_size != 0) {
+        std::filesystem::resize_file(file_path, file_size - partial_record_size);
+      }
+    }
+
+    m_file = std::fopen(file_path.c_str(), "ab");
+    checkCond(m_file != nullptr, "failed opening", file_path, "for writing");
+    if (is_new_file) {
+      auto const header_bytes = header_t::make<ReflexioStruct>().to_bytes();
+      write(header_bytes);
+    }
+  }
+
+  record_file_writer(record_file_writer&& other) noexcept
+    : m_file(std::exchange(other.m_file, nullptr)) {}
+
+  record_file_writer& operator=(record_file_writer&& other) noexcept {
+    std::swap(m_file, other.m_file);
+    return *this;
+  }
+
+  ~record_file_writer() {
+    if (m_file) {
+      std::fclose(m_file);
+    }
+  }
+
+  void append(ReflexioStruct const& record) {
+    std::array<std::byte, ReflexioStruct::get_serial_size()> buffer;
+    to_bytes(buffer.data(), buffer.size(), record);
+    write(buffer);
+  }
+
+  void append(std::span<ReflexioStruct const> records) {
+    for (auto& record : records) {
+      append(record);
+    }
+  }
+
+  void flush() {
+    std::fflush(m_file);
+  }
+
+ private:
+  void write(std::span<std::byte const> bytes) {
+    size_t const num_written = std::fwrite(bytes.data(), 1, bytes.size(), m_file);
+    checkCond(num_written == bytes.size(), "failed writing record:", num_written, "bytes written out of", bytes.size());
+  }
+};
+
+/**
+ * Read-only, memory mapped, random access to the records of a record file.
+ * Note: records appended after the file got mapped are not visible.
+ */
+template <typename ReflexioStruct>
+class record_file {
+  std::byte const* m_data = nullptr;
+  size_t m_mapped_size = 0;
+  size_t m_num_records = 0;
+
+  static constexpr size_t s_header_size = details::record_file_header_t::s_serial_size;
+
+ public:
+  static constexpr size_t record_size() {
+    return ReflexioStruct::get_serial_size();
+  }
+
+  explicit record_file(std::filesystem::path const& file_path) {
+    int const fd = ::open(file_path.c_str(), O_RDONLY);
+    checkCond(fd >= 0, "failed opening", file_path);
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0) {
+      ::close(fd);
+      throwExc("failed reading size of", file_path);
+    }
+    m_mapped_size = static_cast<size_t>(file_stat.st_size);
+    if (m_mapped_size < s_header_size) {
+      ::close(fd);
+      throwExc(file_path, "is too small to be a record file:", m_mapped_size, "bytes");
+    }
+    void* const data = ::mmap(nullptr, m_mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps its own reference to the file
+    checkCond(data != MAP_FAILED, "failed memory mapping", file_path);
+    m_data = static_cast<std::byte const*>(data);
+
+    try {
+      details::record_file_header_t::from_bytes({m_data, s_header_size})
+              .template check_compatible<ReflexioStruct>(file_path);
+    } catch (...) {
+      unmap();
+      throw;
+    }
+    // a trailing partial record (e.g. interrupted write) is ignored. record_file_writer truncates it before appending
+    m_num_records = (m_mapped_size - s_header_size) / record_size();
+  }
+
+  record_file(record_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_mapped_size(std::exchange(other.m_mapped_size, 0))
+    , m_num_records(std::exchange(other.m_num_records, 0)) {}
+
+  record_file& operator=(record_file&& other) noexcept {
+    std::swap(m_data, other.m_data);
+    std::swap(m_mapped_size, other.m_mapped_size);
+    std::swap(m_num_records, other.m_num_records);
+    return *this;
+  }
+
+  ~record_file() {
+    unmap();
+  }
+
+  [[nodiscard]]
+  size_t size() const {
+    return m_num_records;
+  }
+
+  [[nodiscard]]
+  bool empty() const {
+    return m_num_records == 0;
+  }
+
+  // serialized bytes of the record at index
+  [[nodiscard]]
+  std::span<std::byte const> record_bytes(size_t index) const {
+    checkCondDebugOnly(index < m_num_records, "out of range record index", index, ">=", m_num_records);
+    return {m_data + s_header_size + index * record_size(), record_size()};
+  }
+
+  // lazily decoded record, straight from the mapped memory
+  [[nodiscard]]
+  wire_view<ReflexioStruct> view(size_t index) const {
+    return wire_view<ReflexioStruct>{record_bytes(index)};
+  }
+
+  [[nodiscard]]
+  ReflexioStruct operator[](size_t index) const {
+    ReflexioStruct record;
+    auto const bytes = record_bytes(index);
+    from_bytes(bytes.data(), bytes.size(), record);
+    return record;
+  }
+
+  [[nodiscard]]
+  ReflexioStruct at(size_t index) const {
+    checkCond(index < m_num_records, "out of range record index", index, ">=", m_num_records);
+    return (*this)[index];
+  }
+
+ private:
+  void unmap() {
+    if (m_data) {
+      ::munmap(const_cast<std::byte*>(m_data), m_mapped_size);
+      m_data = nullptr;
+    }
+  }
+};
+
+} // namespace reflexio
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+#include "reflexio.hpp"
+
+namespace reflexio {
+
+namespace details {
+// Minimal growable array, used instead of std::vector so that bool columns
+// don't end up in a bit-packed std::vector<bool> and can be exposed as std::span<bool>.
+template <typename T>
+class soa_column_t {
+  std::unique_ptr<T[]> m_data;
+  size_t m_size = 0;
+  size_t m_capacity = 0;
+
+ public:
+  soa_column_t() = default;
+
+  soa_column_t(soa_column_t const& other) {
+    *this = other;
+  }
+
+  soa_column_t(soa_column_t&& other) noexcept
+    : m_data(std::move(other.m_data))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_capacity(std::exchange(other.m_capacity, 0)) {}
+
+  soa_column_t& operator=(soa_column_t const& other) {
+    if (this != &other) {
+      clear();
+      reserve(other.m_size);
+      std::copy(other.m_data.get(), other.m_data.get() + other.m_size, m_data.get());
+      m_size = other.m_size;
+    }
+    return *this;
+  }
+
+  soa_column_t& operator=(soa_column_t&& other) noexcept {
+    if (this != &other) {
+      m_data = std::move(other.m_data);
+      m_size = std::exchange(other.m_size, 0);
+      m_capacity = std::exchange(other.m_capacity, 0);
+    }
+    return *this;
+  }
+
+  [[nodiscard]] size_t size() const { return m_size; }
+  [[nodiscard]] T* data() { return m_data.get(); }
+  [[nodiscard]] T const* data() const { return m_data.get(); }
+  T& operator[](size_t index) { return m_data[index]; }
+  T const& operator[](size_t index) const { return m_data[index]; }
+
+  void reserve(size_t capacity) {
+    if (capacity > m_capacity) {
+      auto data = std::make_unique<T[]>(capacity);
+      std::move(m_data.get(), m_data.get() + m_size, data.get());
+      m_data = std::move(data);
+      m_capacity = capacity;
+    }
+  }
+
+  void push_back(T const& value) {
+    if (m_size == m_capacity) {
+      reserve(m_capacity == 0 ? 8 : 2 * m_capacity);
+    }
+    m_data[m_size++] = value;
+  }
+
+  void pop_back() {
+    m_size--;
+  }
+
+  void resize(size_t new_size, T const& value) {
+    reserve(new_size);
+    std::fill(m_data.get() + std::min(m_size, new_size), m_data.get() + new_size, value);
+    m_size = new_size;
+  }
+
+  void clear() {
+    m_size = 0;
+  }
+
+  operator std::span<T>() { return {data(), m_size}; }
+  operator std::span<T const>() const { return {data(), m_size}; }
+};
+}  // namespace details
+
+/**
+ * Struct of arrays container for reflexio structs: each member variable is stored in its own contiguous column,
+ * so that scanning one field over many records only touches that field's memory.
+ * Records are accessed through row proxies, which convert to and from the reflexio struct.
+ */
+template <typename ReflexioStruct>
+class soa_vector {
+
+  template <size_t Index>
+  using member_type_t = typename ReflexioStruct::template member_var_traits_t<Index, int>::member_type;
+
+  template <size_t... I>
+  static auto make_columns(std::index_sequence<I...>) -> std::tuple<details::soa_column_t<member_type_t<I>>...>;
+
+  using columns_t = decltype(make_columns(std::make_index_sequence<ReflexioStruct::NumMemberVars>()));
+
+  columns_t m_columns;
+
+  template <size_t Index>
+  auto& column_at() { return std::get<Index>(m_columns); }
+  template <size_t Index>
+  auto const& column_at() const { return std::get<Index>(m_columns); }
+
+  template <typename Func>
+  void for_each_column(Func&& func) {
+    std::apply([&func](auto&... columns) { (func(columns), ...); }, m_columns);
+  }
+
+  template <typename Soa>
+  class row_proxy_t {
+    Soa& m_soa;
+    size_t m_index;
+
+   public:
+    constexpr row_proxy_t(Soa& soa, size_t index)
+      : m_soa(soa)
+      , m_index(index) {}
+
+    [[nodiscard]]
+    size_t index() const { return m_index; }
+
+    // e.g. row.get<&S::var1>()
+    template <auto VarPtr>
+    [[nodiscard]]
+    auto& get() const {
+      return m_soa.template column<VarPtr>()[m_index];
+    }
+
+    [[nodiscard]]
+    operator ReflexioStruct() const {
+      return m_soa.get(m_index);
+    }
+
+    row_proxy_t const& operator=(ReflexioStruct const& value) const
+      requires (not std::is_const_v<Soa>) {
+      m_soa.set(m_index, value);
+      return *this;
+    }
+
+    friend bool operator==(row_proxy_t const& row, ReflexioStruct const& value) {
+      return ReflexioStruct(row) == value;
+    }
+  };
+
+ public:
+  using ReflexioT = ReflexioStruct;
+  using row_ref = row_proxy_t<soa_vector>;
+  using const_row_ref = row_proxy_t<soa_vector const>;
+
+  soa_vector() = default;
+
+  explicit soa_vector(std::span<ReflexioStruct const> values) {
+    reserve(values.size());
+    for (auto& value : values) {
+      push_back(value);
+    }
+  }
+
+  [[nodiscard]]
+  size_t size() const {
+    return std::get<0>(m_columns).size();
+  }
+
+  [[nodiscard]]
+  bool empty() const {
+    return size() == 0;
+  }
+
+  void reserve(size_t capacity) {
+    for_each_column([capacity](auto& column) { column.reserve(capacity); });
+  }
+
+  void resize(size_t new_size) {
+    ReflexioStruct const default_value{};
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      column_at<Field::index>().resize(new_size, default_value.*Field::member_var_ptr);
+    });
+  }
+
+  void clear() {
+    for_each_column([](auto& column) { column.clear(); });
+  }
+
+  void push_back(ReflexioStruct const& value) {
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      column_at<Field::index>().push_back(value.*Field::member_var_ptr);
+    });
+  }
+
+  void pop_back() {
+    for_each_column([](auto& column) { column.pop_back(); });
+  }
+
+  // contiguous values of a member variable across all the records, e.g. soa.column<&S::var1>()
+  template <auto VarPtr>
+  [[nodiscard]]
+  std::span<member_type_t<ReflexioStruct::template index_of_var<VarPtr>()>> column() {
+    return column_at<ReflexioStruct::template index_of_var<VarPtr>()>();
+  }
+
+  template <auto VarPtr>
+  [[nodiscard]]
+  std::span<member_type_t<ReflexioStruct::template index_of_var<VarPtr>()> const> column() const {
+    return column_at<ReflexioStruct::template index_of_var<VarPtr>()>();
+  }
+
+  // gathers the record at index
+  [[nodiscard]]
+  ReflexioStruct get(size_t index) const {
+    ReflexioStruct res;
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      res.*Field::member_var_ptr = column_at<Field::index>()[index];
+    });
+    return res;
+  }
+
+  // scatters value into the record at index
+  void set(size_t index, ReflexioStruct const& value) {
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      column_at<Field::index>()[index] = value.*Field::member_var_ptr;
+    });
+  }
+
+  [[nodiscard]]
+  row_ref operator[](size_t index) {
+    return {*this, index};
+  }
+
+  [[nodiscard]]
+  const_row_ref operator[](size_t index) const {
+    return {*this, index};
+  }
+
+  [[nodiscard]]
+  row_ref at(size_t index) {
+    checkCond(index < size(), "out of range access", index, ">=", size());
+    return {*this, index};
+  }
+
+  [[nodiscard]]
+  const_row_ref at(size_t index) const {
+    checkCond(index < size(), "out of range access", index, ">=", size());
+    return {*this, index};
+  }
+
+  [[nodiscard]]
+  row_ref back() {
+    return {*this, size() - 1};
+  }
+
+  [[nodiscard]]
+  const_row_ref back() const {
+    return {*this, size() - 1};
+  }
+};
+
+} // namespace reflexio
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef> // std::byte
+#include <cstring>
+#include <span>
+#include "reflexio.hpp"
+
+namespace reflexio {
+
+/**
+ * Resumable decoder of a stream of reflexio structs serialized back to back with to_bytes
+ * (all member variables included), fed with chunks of arbitrary size as they arrive, e.g. from a socket.
+ * Member variables are decoded straight from the chunks; only a member variable that straddles
+ * two chunks gets staged, in a buffer the size of the largest member variable.
+ * e.g.
+ *   reflexio::stream_decoder<S> decoder;
+ *   while (auto num_bytes = read(fd, buffer, sizeof(buffer)); num_bytes > 0) {
+ *     decoder.feed({buffer, size_t(num_bytes)}, [](S const& record) { ... });
+ *   }
+ */
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+class stream_decoder {
+  static constexpr size_t record_size = ReflexioStruct::get_serial_size();
+
+  static constexpr size_t max_field_size = [] {
+    size_t res = 0;
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      res = std::max(res, Field::descriptor_impl->get_serial_size());
+    });
+    return res;
+  }();
+
+  ReflexioStruct m_record;
+  size_t m_field_index = 0;  // next member variable to decode within m_record
+  std::array<std::byte, max_field_size> m_staged_bytes;
+  size_t m_num_staged_bytes = 0;  // bytes of the member variable at m_field_index received so far
+
+ public:
+  // decodes the records completed by chunk, calling on_record(ReflexioStruct const&) for each of them.
+  // returns the number of completed records
+  template <typename Func>
+  size_t feed(std::span<std::byte const> chunk, Func&& on_record) {
+    auto const& descriptors = ReflexioStruct::get_member_descriptors();
+    size_t num_records = 0;
+    while (not chunk.empty()) {
+      // whole records within the chunk
+      if (m_field_index == 0 and chunk.size() >= record_size) {
+        from_bytes(chunk.data(), record_size, m_record);
+        chunk = chunk.subspan(record_size);
+        on_record(std::as_const(m_record));
+        num_records++;
+        continue;
+      }
+
+      auto const& descriptor = *descriptors[m_field_index];
+      size_t const field_size = descriptor.get_serial_size();
+      if (m_num_staged_bytes == 0 and chunk.size() >= field_size) {
+        descriptor.read_from_bytes(chunk.data(), field_size, &m_record);
+        chunk = chunk.subspan(field_size);
+      } else {
+        // member variable straddling chunks
+        size_t const num_bytes = std::min(field_size - m_num_staged_bytes, chunk.size());
+        std::memcpy(m_staged_bytes.data() + m_num_staged_bytes, chunk.data(), num_bytes);
+        m_num_staged_bytes += num_bytes;
+        chunk = chunk.subspan(num_bytes);
+        if (m_num_staged_bytes < field_size) {
+          break;
+        }
+        descriptor.read_from_bytes(m_staged_bytes.data(), field_size, &m_record);
+        m_num_staged_bytes = 0;
+      }
+
+      if (++m_field_index == ReflexioStruct::NumMemberVars) {
+        m_field_index = 0;
+        on_record(std::as_const(m_record));
+        num_records++;
+      }
+    }
+    return num_records;
+  }
+
+  // number of bytes of the current record received so far
+  [[nodiscard]]
+  size_t num_pending_bytes() const {
+    size_t res = m_num_staged_bytes;
+    auto const& descriptors = ReflexioStruct::get_member_descriptors();
+    for (size_t i = 0; i < m_field_index; i++) {
+      res += descriptors[i]->get_serial_size();
+    }
+    return res;
+  }
+
+  [[nodiscard]]
+  bool has_partial_record() const {
+    return m_field_index != 0 or m_num_staged_bytes != 0;
+  }
+
+  // drops the partially received record, e.g. after a reconnection
+  void reset() {
+    m_record = ReflexioStruct{};
+    m_field_index = 0;
+    m_num_staged_bytes = 0;
+  }
+};
+
+} // namespace reflexio
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef> // std::byte
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "reflexio.hpp"
+
+/**
+ * Tagged binary encoding of reflexio structs, for exchanging data between peers whose struct definitions
+ * may differ (member variables added, removed or reordered).
+ * Unlike the default positional encoding of to_bytes, the stream describes itself:
+ *   - uint16: number of member variables of the writer struct
+ *   - uint32 for each of them: field id (hash of the member variable name and of the structure of its type),
+ *     in the writer declaration order
+ *   - presence bitmap: which of those member variables are encoded (i.e. not excluded by the writer mask)
+ *   - for each present member variable: uint16 payload size, followed by the payload (as serialized by to_bytes).
+ * Readers skip member variables they don't know about, those whose type changed (e.g. int32_t to float or to an enum,
+ * as field ids cover the type) and those whose serial size changed,
+ * and leave their own member variables missing from the stream untouched.
+ */
+
+namespace reflexio {
+
+namespace details {
+
+template <typename T>
+struct tagged_type_traits {
+  static constexpr char kind = 'o';
+};
+template <typename T, size_t N>
+struct tagged_type_traits<std::array<T, N>> {
+  static constexpr char kind = 'a';
+  static constexpr size_t extent = N;
+  using element_type = T;
+};
+template <typename T>
+struct tagged_type_traits<std::vector<T>> {
+  static constexpr char kind = 'v';
+  using element_type = T;
+};
+template <>
+struct tagged_type_traits<std::string> {
+  static constexpr char kind = 's';
+};
+template <size_t N>
+struct tagged_type_traits<std::bitset<N>> {
+  static constexpr char kind = 'B';
+  static constexpr size_t extent = N;
+};
+
+/**
+ * hash of the structure of a type, independent from the compiler and from the type names:
+ * its kind (bool, signed / unsigned integer, floating point, enum, array, vector, string, bitset,
+ * nested reflexio struct) and size, recursively.
+ * e.g. an int32_t member variable retyped to float or to an enum gets another signature.
+ */
+template <typename T>
+constexpr uint64_t tagged_type_signature(uint64_t hash) {
+  auto const add = [&hash](char const kind, size_t const size) {
+    std::array<char, 1 + sizeof(uint64_t)> code{kind};
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+      code[1 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+    }
+    hash = fnv1a_hash({code.data(), code.size()}, hash);
+  };
+  using traits = tagged_type_traits<T>;
+  if constexpr (std::is_same_v<T, bool>) {
+    add('b', sizeof(T));
+  } else if constexpr (std::is_enum_v<T>) {
+    add('e', sizeof(T));
+    hash = tagged_type_signature<std::underlying_type_t<T>>(hash);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    add('f', sizeof(T));
+  } else if constexpr (std::is_integral_v<T>) {
+    add(std::is_signed_v<T> ? 'i' : 'u', sizeof(T));
+  } else if constexpr (reflexio_struct<T>) {
+    add('r', T::NumMemberVars);
+    T::for_each_field([&]<typename Field>(Field) {
+      hash = fnv1a_hash(Field::descriptor_impl->get_name(), hash);
+      hash = tagged_type_signature<typename Field::member_type>(hash);
+    });
+  } else if constexpr (traits::kind == 'a' or traits::kind == 'B') {
+    add(traits::kind, traits::extent);
+    if constexpr (traits::kind == 'a') {
+      hash = tagged_type_signature<typename traits::element_type>(hash);
+    }
+  } else if constexpr (traits::kind == 'v') {
+    add(traits::kind, 0);
+    hash = tagged_type_signature<typename traits::element_type>(hash);
+  } else {
+    add(traits::kind, sizeof(T));
+  }
+  return hash;
+}
+
+// hash of the member variable name and of its type signature
+template <typename MemberType>
+constexpr uint32_t tagged_field_id(std::string_view const field_name) {
+  uint64_t const hash = tagged_type_signature<MemberType>(fnv1a_hash(field_name));
+  return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+template <typename ReflexioStruct>
+struct tagged_schema_t {
+  static constexpr size_t num_fields = ReflexioStruct::NumMemberVars;
+
+  static constexpr std::array<uint32_t, num_fields> field_ids = [] {
+    std::array<uint32_t, num_fields> ids{};
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      ids[Field::index] = tagged_field_id<typename Field::member_type>(Field::descriptor_impl->get_name());
+    });
+    return ids;
+  }();
+
+  // (field id, field index) pairs sorted by id, for lookups while decoding
+  static constexpr std::array<std::pair<uint32_t, size_t>, num_fields> sorted_field_ids = [] {
+    std::array<std::pair<uint32_t, size_t>, num_fields> ids{};
+    for (size_t i = 0; i < num_fields; i++) {
+      ids[i] = {field_ids[i], i};
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }();
+
+  static_assert(std::adjacent_find(sorted_field_ids.begin(), sorted_field_ids.end(),
+                                   [](auto const& a, auto const& b) { return a.first == b.first; })
+                        == sorted_field_ids.end(),
+                "field id collision: rename one of the member variables");
+
+  static constexpr size_t index_of(uint32_t const field_id) {
+    auto it = std::lower_bound(sorted_field_ids.begin(), sorted_field_ids.end(), std::pair{field_id, size_t{0}});
+    return it != sorted_field_ids.end() and it->first == field_id ? it->second : num_fields;
+  }
+
+  static constexpr size_t header_size() {
+    return sizeof(uint16_t) + num_fields * sizeof(uint32_t) + (num_fields + 7) / 8;
+  }
+};
+}  // namespace details
+
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+constexpr size_t serial_size_tagged(ReflexioStruct const&,
+                                    typename ReflexioStruct::Mask const& excludeMask = ReflexioStruct::exclude_none) {
+  size_t const num_present = excludeMask.size() - excludeMask.count();
+  return details::tagged_schema_t<ReflexioStruct>::header_size() +
+         num_present * sizeof(uint16_t) +
+         ReflexioStruct::get_serial_size(excludeMask);
+}
+
+// returns the number of written bytes
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+size_t to_bytes_tagged(std::byte* buffer,
+                       size_t const buffer_size,
+                       ReflexioStruct const& instance,
+                       typename ReflexioStruct::Mask const& excludeMask = ReflexioStruct::exclude_none) {
+  using schema_t = details::tagged_schema_t<ReflexioStruct>;
+  size_t const num_bytes = serial_size_tagged(instance, excludeMask);
+  checkCond(buffer_size >= num_bytes, "output buffer is not big enough to accommodate object", buffer_size, '<', num_bytes);
+
+  using namespace app_utils::serial;
+  size_t res = to_bytes(buffer, buffer_size, static_cast<uint16_t>(schema_t::num_fields));
+  res += to_bytes(buffer + res, buffer_size - res, schema_t::field_ids);
+  res += to_bytes(buffer + res, buffer_size - res, ~excludeMask);
+
+  ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+    if (not excludeMask[Field::index]) {
+      constexpr size_t field_size = Field::descriptor_impl->get_serial_size();
+      static_assert(field_size <= UINT16_MAX, "member variable too large for the tagged encoding");
+      res += to_bytes(buffer + res, buffer_size - res, static_cast<uint16_t>(field_size));
+      res += to_bytes(buffer + res, buffer_size - res, instance.*Field::member_var_ptr);
+    }
+  });
+  return res;
+}
+
+/**
+ * returns the number of bytes read.
+ * A truncated stream fails the checkCond, or stops the decoding and returns 0 in builds where checkCond doesn't throw
+ * (no RTTI): nothing gets read past buffer + buffer_size, whatever the peer sent.
+ * notUpdatedMask: set to the exclude mask of the member variables that did not get updated from the stream
+ */
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+size_t from_bytes_tagged(std::byte const* buffer,
+                         size_t const buffer_size,
+                         ReflexioStruct& instance,
+                         typename ReflexioStruct::Mask& notUpdatedMask) {
+  using schema_t = details::tagged_schema_t<ReflexioStruct>;
+  using namespace app_utils::serial;
+
+  size_t res = 0;
+  auto const check_available = [&](size_t const num_bytes, [[maybe_unused]] char const* what) {
+    checkCond(res + num_bytes <= buffer_size, "truncated tagged", app_utils::typeName<ReflexioStruct>(),
+              ": not enough data left for", what, "required", res + num_bytes, "bytes, found", buffer_size);
+    return res + num_bytes <= buffer_size;
+  };
+
+  notUpdatedMask.set();
+  uint16_t num_fields = 0;
+  if (not check_available(sizeof(num_fields), "the number of fields")) {
+    return 0;
+  }
+  res += from_bytes(buffer + res, buffer_size - res, num_fields);
+
+  size_t const ids_offset = res;
+  size_t const bitmap_size = (num_fields + 7u) / 8u;
+  if (not check_available(num_fields * sizeof(uint32_t) + bitmap_size, "the fields header")) {
+    return 0;
+  }
+  res += num_fields * sizeof(uint32_t);
+  std::byte const* const presence_bitmap = buffer + res;
+  res += bitmap_size;
+
+  auto const& descriptors = ReflexioStruct::get_member_descriptors();
+  for (size_t i = 0; i < num_fields; i++) {
+    bool const is_present = (std::to_integer<uint8_t>(presence_bitmap[i / 8]) >> (i % 8)) & 1u;
+    if (not is_present) {
+      continue;
+    }
+    uint16_t field_size = 0;
+    if (not check_available(sizeof(field_size), "a field size")) {
+      return 0;
+    }
+    res += from_bytes(buffer + res, buffer_size - res, field_size);
+    if (not check_available(field_size, "a field payload")) {
+      return 0;
+    }
+
+    uint32_t field_id = 0;
+    from_bytes(buffer + ids_offset + i * sizeof(uint32_t), sizeof(uint32_t), field_id);
+    size_t const index = schema_t::index_of(field_id);
+    // unknown (or retyped) member variables and member variables whose serial size changed get skipped
+    if (index < schema_t::num_fields and descriptors[index]->get_serial_size() == field_size) {
+      descriptors[index]->read_from_bytes(buffer + res, field_size, &instance);
+      notUpdatedMask.reset(index);
+    }
+    res += field_size;
+  }
+  return res;
+}
+
+template <typename ReflexioStruct>
+  requires is_reflexio_struct<ReflexioStruct>::value
+size_t from_bytes_tagged(std::byte const* buffer,
+                         size_t const buffer_size,
+                         ReflexioStruct& instance) {
+  typename ReflexioStruct::Mask notUpdatedMask;
+  return from_bytes_tagged(buffer, buffer_size, instance, notUpdatedMask);
+}
+
+} // namespace reflexio
@@ -16,7 +16,7 @@ void set(typename ReflexioStruct::Mask& mask, T ReflexioStruct::* ...varPtr) {
 }
 
 template <typename ReflexioStruct, typename ...T>
-void test(typename ReflexioStruct::Mask& mask, T ReflexioStruct::* ...varPtrs) {
+bool test(typename ReflexioStruct::Mask const& mask, T ReflexioStruct::* ...varPtrs) {
   return (mask.test(ReflexioStruct::index_of_var(varPtrs)) || ...);
 }
 
@@ -55,9 +55,11 @@ struct reflexio_view {
 
   // copy only the masked fields
   reflexio_view& operator=(ReflexioStruct const& s) {
-    for (auto& descriptor: *this) {
-      descriptor.copy_value(&object, &s);
-    }
+    ReflexioStruct::for_each_field([&]<typename Field>(Field) {
+      if (not exclude_mask[Field::index]) {
+        object.*Field::member_var_ptr = s.*Field::member_var_ptr;
+      }
+    });
     return *this;
   }
 
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef> // std::byte
+#include <optional>
+#include <span>
+#include <utility>
+#include "reflexio.hpp"
+
+namespace reflexio {
+
+namespace details {
+// whether the serial size of T, and of all its member variables for a reflexio struct, doesn't depend on the instance
+template <typename T>
+constexpr bool has_fixed_serial_layout() {
+  if constexpr (reflexio_struct<T>) {
+    bool res = true;
+    T::for_each_field([&res]<typename Field>(Field) {
+      res = res and has_fixed_serial_layout<typename Field::member_type>();
+    });
+    return res;
+  } else if constexpr (requires { typename T::value_type; std::tuple_size<T>::value; }) {
+    // std::array
+    return has_fixed_serial_layout<typename T::value_type>();
+  } else {
+    return app_utils::serial::fixed_serial_size<T>;
+  }
+}
+}  // namespace details
+
+/**
+ * Read-only view over the serial representation of a reflexio struct, as written by to_bytes with no exclude mask.
+ * Member variables get decoded lazily, on access, from the buffer (no alignment requirement),
+ * at offsets known at compile time: reading a couple of fields doesn't require deserializing the whole struct.
+ */
+template <typename ReflexioStruct>
+class wire_view {
+  static_assert(details::has_fixed_serial_layout<ReflexioStruct>(),
+                "wire_view requires member variables of fixed serial size, as it reads them at compile time offsets");
+
+  std::span<std::byte const> m_buffer;
+
+  template <auto VarPtr>
+  using field_traits_t = typename ReflexioStruct::template member_var_traits_t<ReflexioStruct::template index_of_var<VarPtr>(), int>;
+
+ public:
+  using ReflexioT = ReflexioStruct;
+
+  static constexpr size_t serial_size() {
+    return ReflexioStruct::get_serial_size();
+  }
+
+  // buffer may extend past the serialized struct, e.g. when viewing the front of a sequence of records.
+  // precondition: buffer.size() >= serial_size(). Use try_make for buffers of unchecked size in builds
+  // where checkCond doesn't throw (no RTTI)
+  constexpr explicit wire_view(std::span<std::byte const> buffer)
+    : m_buffer(buffer.first(std::min(buffer.size(), serial_size()))) {
+    checkCond(buffer.size() >= serial_size(), "buffer too small for viewing a serialized",
+              app_utils::typeName<ReflexioStruct>(), buffer.size(), '<', serial_size());
+    // reached in builds where checkCond doesn't throw: get() would read past the end of the buffer
+    assert(buffer.size() >= serial_size());
+  }
+
+  // empty if buffer is too small to hold a serialized struct, in all builds
+  [[nodiscard]]
+  static constexpr std::optional<wire_view> try_make(std::span<std::byte const> buffer) {
+    if (buffer.size() < serial_size()) {
+      return std::nullopt;
+    }
+    return wire_view{buffer};
+  }
+
+  // the serialized bytes of a member variable
+  template <auto VarPtr>
+  [[nodiscard]]
+  constexpr std::span<std::byte const> field_bytes() const {
+    using Field = field_traits_t<VarPtr>;
+    constexpr size_t offset = ReflexioStruct::template get_serial_offset<Field::index>();
+    constexpr size_t size = Field::descriptor_impl->get_serial_size();
+    return m_buffer.template subspan<offset, size>();
+  }
+
+  // decoded value of a member variable, e.g. view.get<&S::var1>()
+  template <auto VarPtr>
+  [[nodiscard]]
+  auto get() const {
+    typename field_traits_t<VarPtr>::member_type value{};
+    auto const bytes = field_bytes<VarPtr>();
+    using namespace app_utils::serial;
+    from_bytes(bytes.data(), bytes.size(), value);
+    return value;
+  }
+
+  // view over a nested reflexio struct member variable, without decoding it
+  template <auto VarPtr>
+    requires is_reflexio_struct<typename field_traits_t<VarPtr>::member_type>::value
+  [[nodiscard]]
+  wire_view<typename field_traits_t<VarPtr>::member_type> view() const {
+    return wire_view<typename field_traits_t<VarPtr>::member_type>{field_bytes<VarPtr>()};
+  }
+
+  // decodes the whole struct
+  [[nodiscard]]
+  ReflexioStruct get() const {
+    ReflexioStruct res;
+    from_bytes(m_buffer.data(), m_buffer.size(), res);
+    return res;
+  }
+
+  [[nodiscard]]
+  constexpr std::span<std::byte const> bytes() const {
+    return m_buffer;
+  }
+};
+
+} // namespace reflexio
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "circular_vector.hpp"
+#include "cond_check.hpp"
+
+/**
+ * Rolling window statistics, updated incrementally rather than by iterating the window on every new value.
+ * An aggregator exposes:
+ *  - push(value): value entered the window
+ *  - pop(value): value, the oldest one of the window, left it
+ *  - clear()
+ * e.g.
+ *   rolling_window_t<double, rolling_mean_variance_t, rolling_max_t<double>> window(10000);
+ *   window.push_back(sample);
+ *   window.get<rolling_max_t<double>>().value();
+ */
+
+// running sum
+template<typename T>
+class rolling_sum_t {
+  T _sum{};
+
+public:
+  void push(T const& value) { _sum += value; }
+  void pop(T const& value) { _sum -= value; }
+  void clear() { _sum = T{}; }
+
+  [[nodiscard]]
+  T const& value() const { return _sum; }
+};
+
+// running mean and variance, with Welford's algorithm for numerical stability
+class rolling_mean_variance_t {
+  size_t _count = 0;
+  double _mean = 0.;
+  double _m2 = 0.; // sum of squared differences from the mean
+
+public:
+  void push(double value) {
+    _count++;
+    double const delta = value - _mean;
+    _mean += delta / double(_count);
+    _m2 += delta * (value - _mean);
+  }
+
+  void pop(double value) {
+    if (_count <= 1) {
+      clear();
+      return;
+    }
+    _count--;
+    double const delta = value - _mean;
+    _mean -= delta / double(_count);
+    _m2 -= delta * (value - _mean);
+    if (_m2 < 0.) {
+      // rounding errors
+      _m2 = 0.;
+    }
+  }
+
+  void clear() {
+    _count = 0;
+    _mean = 0.;
+    _m2 = 0.;
+  }
+
+  [[nodiscard]]
+  size_t count() const { return _count; }
+
+  [[nodiscard]]
+  double mean() const { return _mean; }
+
+  // population variance
+  [[nodiscard]]
+  double variance() const { return _count > 0 ? _m2 / double(_count) : 0.; }
+
+  [[nodiscard]]
+  double sample_variance() const { return _count > 1 ? _m2 / double(_count - 1) : 0.; }
+
+  [[nodiscard]]
+  double stddev() const { return std::sqrt(variance()); }
+};
+
+// running extremum (minimum with Compare = std::less), with a monotonic deque: amortized O(1) per value
+template<typename T, typename Compare>
+class rolling_extremum_t {
+  // candidates for the extremum, from the oldest to the most recent one: the front is the extremum
+  std::deque<T> _candidates;
+  Compare _compare;
+
+public:
+  void push(T const& value) {
+    // values that can't be the extremum anymore, as value is more recent and better
+    while (not _candidates.empty() and _compare(value, _candidates.back())) {
+      _candidates.pop_back();
+    }
+    _candidates.push_back(value);
+  }
+
+  void pop(T const& value) {
+    // the oldest value is still a candidate only if it is the extremum
+    if (not _candidates.empty() and not _compare(_candidates.front(), value)) {
+      _candidates.pop_front();
+    }
+  }
+
+  void clear() { _candidates.clear(); }
+
+  [[nodiscard]]
+  T const& value() const {
+    checkCond(not _candidates.empty(), "empty window");
+    return _candidates.front();
+  }
+};
+
+template<typename T>
+using rolling_min_t = rolling_extremum_t<T, std::less<T>>;
+
+template<typename T>
+using rolling_max_t = rolling_extremum_t<T, std::greater<T>>;
+
+/**
+ * running aggregate for any associative operation Op(T, T) -> T (not necessarily commutative, nor invertible),
+ * e.g. a product, a gcd or a matrix product, in amortized O(1) per value with the two stacks method:
+ * - the back stack gets the new values, along with their aggregate
+ * - the front stack holds, for each of the oldest values, the aggregate from that value to the end of the stack
+ *   and gets refilled from the back stack when empty
+ */
+template<typename T, typename Op>
+class rolling_aggregate_t {
+  Op _op;
+  std::vector<T> _front_aggregates; // the top is the aggregate of all the front stack values
+  std::vector<T> _back_values;
+  T _back_aggregate{};
+
+public:
+  explicit rolling_aggregate_t(Op op = {})
+      : _op(std::move(op)) {}
+
+  void push(T const& value) {
+    _back_aggregate = _back_values.empty() ? value : _op(_back_aggregate, value);
+    _back_values.push_back(value);
+  }
+
+  void pop(T const&) {
+    if (_front_aggregates.empty()) {
+      for (auto it = _back_values.rbegin(); it != _back_values.rend(); ++it) {
+        _front_aggregates.push_back(_front_aggregates.empty() ? *it : _op(*it, _front_aggregates.back()));
+      }
+      _back_values.clear();
+    }
+    checkCond(not _front_aggregates.empty(), "empty window");
+    _front_aggregates.pop_back();
+  }
+
+  void clear() {
+    _front_aggregates.clear();
+    _back_values.clear();
+  }
+
+  [[nodiscard]]
+  T value() const {
+    checkCond(not _front_aggregates.empty() or not _back_values.empty(), "empty window");
+    if (_front_aggregates.empty()) {
+      return _back_aggregate;
+    } else if (_back_values.empty()) {
+      return _front_aggregates.back();
+    }
+    return _op(_front_aggregates.back(), _back_aggregate);
+  }
+};
+
+// circular_vector_t that keeps its aggregators up to date as values enter and leave the window
+template<typename T, typename ...Aggregators>
+class rolling_window_t {
+
+  circular_vector_t<T> _values;
+  std::tuple<Aggregators...> _aggregators;
+
+public:
+
+  explicit rolling_window_t(size_t capacity)
+      : _values(capacity) {}
+
+  // for aggregators that are not default constructible, e.g. a rolling_aggregate_t with a capturing lambda
+  rolling_window_t(size_t capacity, Aggregators... aggregators) requires (sizeof...(Aggregators) > 0)
+      : _values(capacity)
+      , _aggregators(std::move(aggregators)...) {}
+
+  [[nodiscard]]
+  circular_vector_t<T> const& values() const {
+    return _values;
+  }
+
+  [[nodiscard]]
+  size_t size() const {
+    return _values.size();
+  }
+
+  [[nodiscard]]
+  size_t capacity() const {
+    return _values.capacity();
+  }
+
+  [[nodiscard]]
+  bool empty() const {
+    return _values.empty();
+  }
+
+  template<typename Aggregator>
+  [[nodiscard]]
+  Aggregator const& get() const {
+    return std::get<Aggregator>(_aggregators);
+  }
+
+  template<size_t I>
+  [[nodiscard]]
+  auto const& get() const {
+    return std::get<I>(_aggregators);
+  }
+
+  // once the window is full, the oldest value leaves the window
+  void push_back(T const& value) {
+    if (_values.size() == _values.capacity() and not _values.empty()) {
+      std::apply([&](auto& ...aggregators) { (aggregators.pop(_values.front()), ...); }, _aggregators);
+    }
+    _values.push_back(value);
+    std::apply([&](auto& ...aggregators) { (aggregators.push(value), ...); }, _aggregators);
+  }
+
+  void pop_front(size_t N = 1) {
+    for (size_t i = 0; i < N and not _values.empty(); i++) {
+      std::apply([&](auto& ...aggregators) { (aggregators.pop(_values.front()), ...); }, _aggregators);
+      _values.pop_front();
+    }
+  }
+
+  void clear() {
+    _values.clear();
+    std::apply([](auto& ...aggregators) { (aggregators.clear(), ...); }, _aggregators);
+  }
+};
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef> // std::byte
+#include <cstring>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+#include "serial_buffer.hpp"
+
+// to be included after serial_utils.hpp
+
+namespace app_utils::serial {
+
+namespace details {
+
+// free buffers of a buffer_pool, shared with the buffers it lent so that they can outlive it
+struct buffer_pool_state_t {
+  static constexpr size_t min_size_class_log2 = 6;
+  static constexpr size_t num_size_classes = 21;
+
+  std::array<std::vector<std::vector<std::byte>>, num_size_classes> free_buffers;
+  size_t max_free_buffers_per_class;
+
+  // smallest size class that fits num_bytes, num_size_classes if too large for the pool
+  static constexpr size_t size_class(size_t const num_bytes) {
+    size_t const log2 = num_bytes <= 1 ? 0 : std::bit_width(num_bytes - 1);
+    return log2 <= min_size_class_log2 ? 0 : std::min(log2 - min_size_class_log2, num_size_classes);
+  }
+
+  static constexpr size_t size_class_capacity(size_t const size_class) {
+    return size_t{1} << (min_size_class_log2 + size_class);
+  }
+
+  std::vector<std::byte> acquire(size_t const num_bytes) {
+    size_t const index = size_class(num_bytes);
+    std::vector<std::byte> bytes;
+    if (index < num_size_classes and not free_buffers[index].empty()) {
+      bytes = std::move(free_buffers[index].back());
+      free_buffers[index].pop_back();
+    } else {
+      bytes.reserve(index < num_size_classes ? size_class_capacity(index) : num_bytes);
+    }
+    bytes.resize(num_bytes);
+    return bytes;
+  }
+
+  void release(std::vector<std::byte>&& bytes) {
+    // largest size class that the buffer capacity can serve
+    size_t const capacity = bytes.capacity();
+    if (capacity < size_class_capacity(0)) {
+      return;
+    }
+    size_t const index = std::bit_width(capacity) - 1 - min_size_class_log2;
+    if (index < num_size_classes and free_buffers[index].size() < max_free_buffers_per_class) {
+      bytes.clear();
+      free_buffers[index].push_back(std::move(bytes));
+    }
+  }
+};
+}  // namespace details
+
+class buffer_pool;
+
+// byte buffer borrowed from a buffer_pool, returned to it on destruction.
+// May outlive its pool: its bytes then simply get freed
+class pooled_buffer {
+  std::vector<std::byte> m_bytes;
+  std::weak_ptr<details::buffer_pool_state_t> m_pool;
+
+  friend class buffer_pool;
+  pooled_buffer(std::vector<std::byte>&& bytes, std::weak_ptr<details::buffer_pool_state_t> pool)
+    : m_bytes(std::move(bytes))
+    , m_pool(std::move(pool)) {}
+
+  void release() {
+    if (auto const pool = m_pool.lock()) {
+      pool->release(std::move(m_bytes));
+    }
+    m_pool.reset();
+  }
+
+ public:
+  pooled_buffer() = default;
+  pooled_buffer(pooled_buffer&& other) noexcept
+    : m_bytes(std::move(other.m_bytes))
+    , m_pool(std::move(other.m_pool)) {}
+  pooled_buffer& operator=(pooled_buffer&& other) noexcept;
+  ~pooled_buffer();
+
+  [[nodiscard]] std::byte* data() { return m_bytes.data(); }
+  [[nodiscard]] std::byte const* data() const { return m_bytes.data(); }
+  [[nodiscard]] size_t size() const { return m_bytes.size(); }
+  [[nodiscard]] size_t capacity() const { return m_bytes.capacity(); }
+  [[nodiscard]] bool empty() const { return m_bytes.empty(); }
+
+  // beyond capacity, swaps for a buffer of a bigger size class from the pool
+  void resize(size_t new_size);
+
+  operator std::span<std::byte>() { return m_bytes; }
+  operator std::span<std::byte const>() const { return m_bytes; }
+  [[nodiscard]] std::vector<std::byte> const& bytes() const { return m_bytes; }
+};
+
+/**
+ * Pool of reusable byte buffers, bucketed by power of 2 size classes (from 64 bytes up to 64MB),
+ * so that serializing messages doesn't go through the allocator once the pool is warm.
+ * Buffers larger than the biggest size class are allocated and freed normally.
+ * Lent buffers only hold a weak reference to the pool, and may outlive it.
+ * NOTE: not thread safe. Use one pool per thread (e.g. buffer_pool::thread_local_instance()),
+ * and release buffers on the thread that acquired them.
+ */
+class buffer_pool {
+  std::shared_ptr<details::buffer_pool_state_t> m_state;
+
+ public:
+  static constexpr size_t min_size_class_log2 = details::buffer_pool_state_t::min_size_class_log2;
+  static constexpr size_t num_size_classes = details::buffer_pool_state_t::num_size_classes;
+
+  explicit buffer_pool(size_t max_free_buffers_per_class = 16)
+    : m_state(std::make_shared<details::buffer_pool_state_t>()) {
+    m_state->max_free_buffers_per_class = max_free_buffers_per_class;
+  }
+
+  buffer_pool(buffer_pool const&) = delete;
+  buffer_pool& operator=(buffer_pool const&) = delete;
+
+  static buffer_pool& thread_local_instance() {
+    thread_local buffer_pool pool;
+    return pool;
+  }
+
+  // smallest size class that fits num_bytes, num_size_classes if too large for the pool
+  static constexpr size_t size_class(size_t const num_bytes) {
+    return details::buffer_pool_state_t::size_class(num_bytes);
+  }
+
+  static constexpr size_t size_class_capacity(size_t const size_class) {
+    return details::buffer_pool_state_t::size_class_capacity(size_class);
+  }
+
+  // buffer of num_bytes bytes, whose capacity is that of its size class
+  [[nodiscard]]
+  pooled_buffer acquire(size_t const num_bytes) {
+    return {m_state->acquire(num_bytes), m_state};
+  }
+
+  void release(std::vector<std::byte>&& bytes) {
+    m_state->release(std::move(bytes));
+  }
+
+  // number of buffers available for reuse
+  [[nodiscard]]
+  size_t num_free_buffers() const {
+    size_t res = 0;
+    for (auto const& free_buffers : m_state->free_buffers) {
+      res += free_buffers.size();
+    }
+    return res;
+  }
+
+  void clear() {
+    for (auto& free_buffers : m_state->free_buffers) {
+      free_buffers.clear();
+    }
+  }
+};
+
+inline pooled_buffer& pooled_buffer::operator=(pooled_buffer&& other) noexcept {
+  if (this != &other) {
+    release();
+    m_bytes = std::move(other.m_bytes);
+    m_pool = std::move(other.m_pool);
+  }
+  return *this;
+}
+
+inline pooled_buffer::~pooled_buffer() {
+  release();
+}
+
+inline void pooled_buffer::resize(size_t const new_size) {
+  if (new_size > m_bytes.capacity()) {
+    if (auto const pool = m_pool.lock()) {
+      // swap for a buffer of the right size class, so that the old one goes back to the pool
+      std::vector<std::byte> bigger = pool->acquire(new_size);
+      std::memcpy(bigger.data(), m_bytes.data(), m_bytes.size());
+      std::swap(m_bytes, bigger);
+      pool->release(std::move(bigger));
+      return;
+    }
+  }
+  m_bytes.resize(new_size);
+}
+
+template<typename ...Args>
+pooled_buffer make_buffer(buffer_pool& pool, Args&&... args) {
+  size_t const num_bytes = serial_size(std::forward<Args>(args)...);
+  pooled_buffer buffer = pool.acquire(num_bytes);
+  to_bytes(buffer, std::forward<Args>(args)...);
+  return buffer;
+}
+
+template<typename ...Args>
+void append_to_buffer(pooled_buffer& buffer, Args&&... args) {
+  size_t const num_bytes = serial_size(std::forward<Args>(args)...);
+  size_t initial_size = buffer.size();
+  buffer.resize(initial_size + num_bytes);
+  to_bytes({buffer.data() + initial_size, num_bytes}, std::forward<Args>(args)...);
+}
+
+}  // namespace app_utils::serial
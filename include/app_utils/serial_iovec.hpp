@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <cstddef> // std::byte
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#else
+#error "iovec_sink relies on struct iovec, which is only available on POSIX platforms"
+#endif
+
+#include "cond_check.hpp"
+#include "serial_type_utils.hpp"
+
+namespace app_utils::serial {
+
+/**
+ * Scatter/gather serialization sink: produces the same bytes as to_bytes(args...), as a sequence of iovec entries
+ * ready for writev / sendmsg.
+ * Large contiguous payloads (string_views, spans, std::arrays, and the contents of std::strings and std::vectors
+ * of memcpy serializable elements) are referenced in place rather than copied;
+ * everything else (headers, small payloads) gets serialized into an internal buffer.
+ * NOTE: referenced values must outlive the use of iovecs().
+ */
+class iovec_sink {
+  // data == nullptr: segment of the internal buffer, starting at offset
+  struct segment_t {
+    std::byte const* data;
+    size_t offset;
+    size_t size;
+  };
+
+  std::vector<std::byte> m_copied_bytes;
+  std::vector<segment_t> m_segments;
+  std::vector<iovec> m_iovecs;
+  size_t m_size = 0;
+  size_t m_min_reference_size;
+
+  template <typename T>
+  static constexpr bool is_raw_bytes_v = is_memcpy_serializable<std::remove_cv_t<T>>::value or
+                                         std::is_same_v<std::remove_cv_t<T>, std::byte>;
+
+  std::byte* reserve_copied_bytes(size_t const num_bytes) {
+    size_t const offset = m_copied_bytes.size();
+    m_copied_bytes.resize(offset + num_bytes);
+    if (not m_segments.empty() and m_segments.back().data == nullptr) {
+      m_segments.back().size += num_bytes;
+    } else {
+      m_segments.push_back({nullptr, offset, num_bytes});
+    }
+    m_size += num_bytes;
+    return m_copied_bytes.data() + offset;
+  }
+
+  template <typename T>
+  void copy(T const& val) {
+    size_t const num_bytes = serial_size(val);
+    to_bytes(reserve_copied_bytes(num_bytes), num_bytes, val);
+  }
+
+  void reference(std::byte const* data, size_t const num_bytes) {
+    if (num_bytes < m_min_reference_size) {
+      std::memcpy(reserve_copied_bytes(num_bytes), data, num_bytes);
+      return;
+    }
+    m_segments.push_back({data, 0, num_bytes});
+    m_size += num_bytes;
+  }
+
+  template <typename T>
+  void append_one(T const& val) {
+    copy(val);
+  }
+
+  void append_one(std::string_view const& val) {
+    reference(reinterpret_cast<std::byte const*>(val.data()), val.size());
+  }
+
+  template <typename T, size_t Extent>
+    requires is_raw_bytes_v<T>
+  void append_one(std::span<T, Extent> const& val) {
+    reference(reinterpret_cast<std::byte const*>(val.data()), val.size_bytes());
+  }
+
+  template <typename T, size_t N>
+    requires is_raw_bytes_v<T>
+  void append_one(std::array<T, N> const& val) {
+    reference(reinterpret_cast<std::byte const*>(val.data()), sizeof(val));
+  }
+
+  // 1 byte size prefix, as for to_bytes
+  void append_one(std::string const& val) {
+    checkCond(val.size() <= 0xFF, "string too long for a 1 byte size prefix:", val.size());
+    copy(static_cast<uint8_t>(val.size()));
+    reference(reinterpret_cast<std::byte const*>(val.data()), val.size());
+  }
+
+  template <typename T>
+    requires is_raw_bytes_v<T>
+  void append_one(std::vector<T> const& val) {
+    checkCond(val.size() <= 0xFF, "vector too long for a 1 byte size prefix:", val.size());
+    copy(static_cast<uint8_t>(val.size()));
+    reference(reinterpret_cast<std::byte const*>(val.data()), val.size() * sizeof(T));
+  }
+
+ public:
+  // payloads smaller than min_reference_size get copied, as an iovec entry costs more than copying a few bytes
+  explicit iovec_sink(size_t min_reference_size = 64)
+    : m_min_reference_size(min_reference_size) {}
+
+  template <typename... Args>
+  void append(Args const&... args) {
+    (append_one(args), ...);
+  }
+
+  // total number of serialized bytes
+  [[nodiscard]]
+  size_t size() const {
+    return m_size;
+  }
+
+  [[nodiscard]]
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  void clear() {
+    m_copied_bytes.clear();
+    m_segments.clear();
+    m_iovecs.clear();
+    m_size = 0;
+  }
+
+  // valid until the next call to append or clear
+  [[nodiscard]]
+  std::span<iovec const> iovecs() {
+    // resolved lazily, as the internal buffer may get reallocated while appending
+    m_iovecs.resize(m_segments.size());
+    for (size_t i = 0; i < m_segments.size(); i++) {
+      auto const& segment = m_segments[i];
+      std::byte const* data = segment.data ? segment.data : m_copied_bytes.data() + segment.offset;
+      m_iovecs[i] = {const_cast<std::byte*>(data), segment.size};
+    }
+    return m_iovecs;
+  }
+
+  // copies the serialized bytes into buffer, returns the number of written bytes
+  size_t copy_to(std::byte* buffer, size_t const buffer_size) {
+    checkCond(buffer_size >= m_size, "output buffer is not big enough", buffer_size, '<', m_size);
+    size_t num_bytes = 0;
+    for (auto const& entry : iovecs()) {
+      std::memcpy(buffer + num_bytes, entry.iov_base, entry.iov_len);
+      num_bytes += entry.iov_len;
+    }
+    return num_bytes;
+  }
+};
+
+}  // namespace app_utils::serial
@@ -6,13 +6,93 @@
 #include <string>
 #include <vector>
 #include <bitset>
+#include <complex>
 #include <array>
 #include <span>
+#include <algorithm>
 #include <bit>
+#include <concepts>
+#include <cstdint>
+#include "cond_check.hpp"
 
 namespace app_utils::serial {
 
-static_assert(std::endian::native == std::endian::little, "serialization logic assumes little-endian format");
+/**
+ * Byte order of the serialized data: little-endian by default, whatever the platform,
+ * or big-endian (network order) when APP_UTILS_SERIAL_BIG_ENDIAN is defined.
+ * Multi-byte arithmetic values get byte swapped when the platform byte order differs,
+ * which also disables the memcpy based fast paths (see is_memcpy_serializable).
+ * Other multi-byte trivially copyable types then need their own to_bytes/from_bytes overloads (see std::complex).
+ * tests/CMakeLists.txt builds the test suite in both byte orders.
+ */
+#ifdef APP_UTILS_SERIAL_BIG_ENDIAN
+inline constexpr std::endian serial_byte_order = std::endian::big;
+#else
+inline constexpr std::endian serial_byte_order = std::endian::little;
+#endif
+inline constexpr bool serial_needs_byteswap = serial_byte_order != std::endian::native;
+static_assert(std::endian::native == std::endian::little or std::endian::native == std::endian::big,
+              "mixed-endian platforms are not supported");
+
+namespace details {
+template <typename UInt>
+constexpr UInt byteswap_uint(UInt val) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (sizeof(UInt) == 2) {
+    return __builtin_bswap16(val);
+  } else if constexpr (sizeof(UInt) == 4) {
+    return __builtin_bswap32(val);
+  } else if constexpr (sizeof(UInt) == 8) {
+    return __builtin_bswap64(val);
+  }
+#endif
+  UInt res = 0;
+  for (size_t i = 0; i < sizeof(UInt); i++) {
+    res = static_cast<UInt>((res << 8) | ((val >> (8 * i)) & 0xFF));
+  }
+  return res;
+}
+
+template <size_t Size>
+struct uint_of_size;
+template <> struct uint_of_size<1> { using type = uint8_t; };
+template <> struct uint_of_size<2> { using type = uint16_t; };
+template <> struct uint_of_size<4> { using type = uint32_t; };
+template <> struct uint_of_size<8> { using type = uint64_t; };
+}  // namespace details
+
+// std::byteswap (C++23), extended to floating point types
+template <typename T>
+  requires std::is_arithmetic_v<T>
+constexpr T byteswap(T const val) {
+  using UInt = typename details::uint_of_size<sizeof(T)>::type;
+  return std::bit_cast<T>(details::byteswap_uint(std::bit_cast<UInt>(val)));
+}
+
+// copy of num_values arithmetic values with their bytes swapped, written so that it gets vectorized
+template <typename T>
+  requires std::is_arithmetic_v<T>
+void byteswap_copy(std::byte* dst, T const* src, size_t const num_values) {
+  using UInt = typename details::uint_of_size<sizeof(T)>::type;
+  for (size_t i = 0; i < num_values; i++) {
+    UInt val;
+    std::memcpy(&val, src + i, sizeof(T));
+    val = details::byteswap_uint(val);
+    std::memcpy(dst + i * sizeof(T), &val, sizeof(T));
+  }
+}
+
+template <typename T>
+  requires std::is_arithmetic_v<T>
+void byteswap_copy(T* dst, std::byte const* src, size_t const num_values) {
+  using UInt = typename details::uint_of_size<sizeof(T)>::type;
+  for (size_t i = 0; i < num_values; i++) {
+    UInt val;
+    std::memcpy(&val, src + i * sizeof(T), sizeof(T));
+    val = details::byteswap_uint(val);
+    std::memcpy(dst + i, &val, sizeof(T));
+  }
+}
 
 /**
  * serial_size(...) exists in different flavors:
@@ -20,6 +100,22 @@ static_assert(std::endian::native == std::endian::little, "serialization logic a
  *      as that pointer can be nullptr.
  *  - a set of overloads that take a const& for types whose serialization size depend on the instance (e.g. vector, string, string_view)
  */
+/**
+ * Types whose serial representation is a plain copy of their in-memory representation,
+ * so that a contiguous sequence of them can be serialized with a single memcpy.
+ * Can be specialized for custom trivially copyable types that use the default memcpy based serialization.
+ * Multi-byte types aren't when the serialized byte order differs from the platform one.
+ * Note: bool is excluded as deserialization normalizes any non-zero byte to true.
+ */
+template<typename T>
+struct is_memcpy_serializable
+    : std::bool_constant<std::is_arithmetic_v<T> and not std::is_same_v<T, bool> and
+                         (sizeof(T) == 1 or not serial_needs_byteswap)> {};
+
+template<typename T, size_t N>
+struct is_memcpy_serializable<std::array<T, N>>
+    : std::bool_constant<is_memcpy_serializable<T>::value and sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
 template<typename T>
   requires (std::is_trivially_copyable_v<T> and not std::is_same_v<T, char>)
 constexpr size_t serial_size(T const*) {
@@ -49,6 +145,26 @@ constexpr size_t serial_size(std::bitset<N> const*) {
   return (N + 7) / 8; // round up to the nearest number of bytes // == sizeof(val) ?
 }
 
+/**
+ * Types whose serial size doesn't depend on the instance, i.e. that have a serial_size(T const*) overload,
+ * e.g. arithmetic types, std::array, std::bitset, enumatic enums and reflexio structs with fixed size members.
+ * fixed_serial_size_v is usable in constant expressions, e.g. for sizing stack buffers.
+ */
+template <typename T>
+concept fixed_serial_size = requires { serial_size(static_cast<T const*>(nullptr)); };
+
+template <typename T>
+struct is_fixed_serial_size : std::bool_constant<fixed_serial_size<T>> {};
+
+template <typename T>
+  requires fixed_serial_size<T>
+inline constexpr size_t fixed_serial_size_v = serial_size(static_cast<T const*>(nullptr));
+
+// buffer that fits the serialization of values of types T...
+template <typename... T>
+  requires (fixed_serial_size<T> and ...)
+using static_buffer_t = std::array<std::byte, (fixed_serial_size_v<T> + ... + 0)>;
+
 template<typename T>
   requires (not std::is_pointer_v<T>)
 constexpr size_t serial_size(T const& val) {
@@ -104,6 +220,10 @@ constexpr size_t from_bytes(std::byte const* buffer, size_t /*buffer_size*/, T&
 #if defined(__GNUC__)  && !defined(__clang__)
 #pragma GCC diagnostic pop
 #endif
+  if constexpr (serial_needs_byteswap and sizeof(T) > 1) {
+    static_assert(std::is_arithmetic_v<T>, "no byte order conversion for this type: it requires its own from_bytes overload");
+    val = byteswap(val);
+  }
   return num_bytes;
 }
 
@@ -111,7 +231,13 @@ template <typename T>
   requires (std::is_trivially_copyable_v<T> and not std::is_enum_v<T>)
 constexpr size_t to_bytes(std::byte* buffer, size_t /*buffer_size*/, T const& val) {
   size_t num_bytes = serial_size(val);
-  std::memcpy(buffer, &val, num_bytes);
+  if constexpr (serial_needs_byteswap and sizeof(T) > 1) {
+    static_assert(std::is_arithmetic_v<T>, "no byte order conversion for this type: it requires its own to_bytes overload");
+    T const swapped = byteswap(val);
+    std::memcpy(buffer, &swapped, num_bytes);
+  } else {
+    std::memcpy(buffer, &val, num_bytes);
+  }
   return num_bytes;
 }
 
@@ -157,9 +283,29 @@ constexpr size_t to_bytes(std::byte* buffer, size_t buffer_size, T const& val) {
   return num_bytes;
 }
 
+/**
+ * std::complex, element-wise so that both parts follow the serialized byte order
+ */
+template <typename T>
+constexpr size_t from_bytes(std::byte const* buffer, size_t buffer_size, std::complex<T>& val) {
+  T real;
+  T imag;
+  size_t num_bytes = from_bytes(buffer, buffer_size, real);
+  num_bytes += from_bytes(buffer + num_bytes, buffer_size - num_bytes, imag);
+  val = {real, imag};
+  return num_bytes;
+}
+
+template <typename T>
+constexpr size_t to_bytes(std::byte* buffer, size_t buffer_size, std::complex<T> const& val) {
+  size_t num_bytes = to_bytes(buffer, buffer_size, val.real());
+  num_bytes += to_bytes(buffer + num_bytes, buffer_size - num_bytes, val.imag());
+  return num_bytes;
+}
+
 /**
  * std::string
- * NOTE: size cannot exceed 256
+ * NOTE: size cannot exceed 255, see varint_sized for larger strings
  */
 inline size_t from_bytes(std::byte const* buffer, size_t /*buffer_size*/, std::string& val) {
   size_t str_size = std::to_integer<size_t>(buffer[0]);
@@ -170,6 +316,7 @@ inline size_t from_bytes(std::byte const* buffer, size_t /*buffer_size*/, std::s
 
 inline size_t to_bytes(std::byte* buffer, size_t /*buffer_size*/, std::string const& val) {
   size_t str_size = val.size();
+  checkCond(str_size <= 0xFF, "string too long for a 1 byte size prefix:", str_size, "use varint_sized<std::string>");
   buffer[0] = static_cast<std::byte>(str_size);
   std::memcpy(buffer+1, val.c_str(), str_size);
   return str_size + 1;
@@ -190,18 +337,49 @@ constexpr size_t to_bytes(std::byte* buffer, size_t /*buffer_size*/, char const
   return N;
 }
 
+/**
+ * std::bitset
+ * Serialized little-endian, bit i in byte i/8.
+ * Standard libraries store bitsets as arrays of words with the bits beyond N kept at 0, which on little-endian platforms
+ * is the serialized representation (whatever serial_byte_order): the bytes get copied at once. Other libraries go through to_ullong 64 bits at a time.
+ */
+#if (defined(__GLIBCXX__) || defined(_LIBCPP_VERSION) || defined(_MSC_VER)) && !defined(APP_UTILS_NO_BITSET_WORD_STORAGE)
+#define APP_UTILS_BITSET_WORD_STORAGE
+#endif
+
+namespace details {
+template <size_t N>
+constexpr bool has_bitset_word_storage() {
+#ifdef APP_UTILS_BITSET_WORD_STORAGE
+  return std::endian::native == std::endian::little and
+         std::is_trivially_copyable_v<std::bitset<N>> and sizeof(std::bitset<N>) >= (N + 7) / 8;
+#else
+  return false;
+#endif
+}
+}  // namespace details
+
 template<size_t N>
 size_t from_bytes(std::byte const* buffer, size_t buffer_size, std::bitset<N>& val) {
   // note: for backward compatibility, allow a serial size smaller than buffer size.
   size_t num_bytes = std::min(serial_size(val), buffer_size);
   val.reset();
-  for (size_t i = 0; i < N; i++) {
-    if (i/8 >= num_bytes) {
-      break;
+  if constexpr (details::has_bitset_word_storage<N>()) {
+    std::memcpy(reinterpret_cast<std::byte*>(&val), buffer, num_bytes);
+    if constexpr (N % 8 != 0) {
+      if (num_bytes == serial_size(val)) {
+        // bits beyond N must stay cleared
+        auto* last_byte = reinterpret_cast<std::byte*>(&val) + num_bytes - 1;
+        *last_byte &= std::byte((1u << N % 8) - 1);
+      }
     }
-    auto b = std::byte(1 << i % 8);
-    if ((buffer[i/8] & b) == b) {
-      val.set(i);
+  } else {
+    for (size_t i = 0; i < num_bytes; i += 8) {
+      uint64_t word = 0;
+      for (size_t j = 0; j < 8 and i + j < num_bytes; j++) {
+        word |= std::to_integer<uint64_t>(buffer[i + j]) << (8 * j);
+      }
+      val |= std::bitset<N>(word) << (8 * i);
     }
   }
   return num_bytes;
@@ -210,16 +388,20 @@ size_t from_bytes(std::byte const* buffer, size_t buffer_size, std::bitset<N>& v
 template<size_t N>
 size_t to_bytes(std::byte* buffer, size_t /*buffer_size*/, std::bitset<N> const& val) {
   size_t num_bytes = serial_size(val);
-  std::memset(buffer, 0, num_bytes);
-  for (size_t i = 0; i < N; i++) {
-    if (val.test(i)) {
-      buffer[i/8] |= std::byte(1 << i % 8);
+  if constexpr (details::has_bitset_word_storage<N>()) {
+    std::memcpy(buffer, reinterpret_cast<std::byte const*>(&val), num_bytes);
+  } else {
+    std::bitset<N> const word_mask(~uint64_t{0});
+    for (size_t i = 0; i < num_bytes; i += 8) {
+      uint64_t const word = ((val >> (8 * i)) & word_mask).to_ullong();
+      for (size_t j = 0; j < 8 and i + j < num_bytes; j++) {
+        buffer[i + j] = static_cast<std::byte>(word >> (8 * j));
+      }
     }
   }
   return num_bytes;
 }
 
-
 /**
  * C-style array
  */
@@ -243,6 +425,10 @@ constexpr size_t to_bytes(std::byte* buffer, size_t /*buffer_size*/, T const (&v
 
 template <typename T, size_t N>
 constexpr size_t from_bytes(std::byte const* buffer, size_t buffer_size, std::array<T, N>& val) {
+  if constexpr (serial_needs_byteswap and std::is_arithmetic_v<T> and not std::is_same_v<T, bool> and sizeof(T) > 1) {
+    byteswap_copy(val.data(), buffer, N);
+    return N * sizeof(T);
+  }
   size_t num_bytes = 0;
   for (auto& item : val) {
     num_bytes += from_bytes(buffer + num_bytes, buffer_size - num_bytes, item);
@@ -252,6 +438,10 @@ constexpr size_t from_bytes(std::byte const* buffer, size_t buffer_size, std::ar
 
 template <typename T, size_t N>
 constexpr size_t to_bytes(std::byte* const buffer, size_t const buffer_size, std::array<T, N> const& val) {
+  if constexpr (serial_needs_byteswap and std::is_arithmetic_v<T> and not std::is_same_v<T, bool> and sizeof(T) > 1) {
+    byteswap_copy(buffer, val.data(), N);
+    return N * sizeof(T);
+  }
   size_t num_bytes = 0;
   for (auto& item : val) {
     num_bytes += to_bytes(buffer + num_bytes, buffer_size - num_bytes, item);
@@ -261,6 +451,7 @@ constexpr size_t to_bytes(std::byte* const buffer, size_t const buffer_size, std
 
 /**
  * std::vector
+ * NOTE: size cannot exceed 255, see varint_sized for larger vectors
  */
 
 template<typename T>
@@ -277,6 +468,7 @@ size_t from_bytes(std::byte const* buffer, size_t buffer_size, std::vector<T>& v
 template <typename T>
 size_t to_bytes(std::byte* buffer, size_t buffer_size, std::vector<T> const& val) {
   size_t str_size = val.size();
+  checkCond(str_size <= 0xFF, "vector too long for a 1 byte size prefix:", str_size, "use varint_sized<std::vector>");
   buffer[0] = static_cast<std::byte>(str_size);
   size_t num_bytes = 1;
   for (auto& item : val) {
@@ -293,4 +485,344 @@ size_t to_bytes(std::byte* buffer, size_t buffer_size, std::span<T> const& val)
   }
   return num_bytes;
 }
+
+/**
+ * Variable length integers (LEB128): 7 bits per byte, least significant group first,
+ * with the high bit set on every byte but the last one.
+ * Signed values get zigzag encoded first so that small negative values also take few bytes.
+ */
+constexpr uint64_t zigzag_encode(int64_t const val) {
+  return (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+}
+
+constexpr int64_t zigzag_decode(uint64_t const val) {
+  return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+constexpr size_t varint_size(uint64_t val) {
+  size_t num_bytes = 1;
+  for (; val >= 0x80; val >>= 7) {
+    num_bytes++;
+  }
+  return num_bytes;
+}
+
+constexpr size_t to_varint(std::byte* buffer, uint64_t val) {
+  size_t num_bytes = 0;
+  for (; val >= 0x80; val >>= 7) {
+    buffer[num_bytes++] = static_cast<std::byte>(val | 0x80);
+  }
+  buffer[num_bytes++] = static_cast<std::byte>(val);
+  return num_bytes;
+}
+
+// returns the number of bytes read, or 0 if the buffer ends before the varint does
+// or if the varint doesn't fit in 64 bits
+constexpr size_t from_varint(std::byte const* buffer, size_t const buffer_size, uint64_t& val) {
+  constexpr size_t max_num_bytes = (64 + 6) / 7;
+  val = 0;
+  for (size_t i = 0; i < buffer_size and i < max_num_bytes; i++) {
+    auto const byte = std::to_integer<uint64_t>(buffer[i]);
+    if (i == max_num_bytes - 1 and byte > 0x01) {
+      // the last byte only holds the 64th bit, and can't be continued
+      return 0;
+    }
+    val |= (byte & 0x7F) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+inline size_t read_varint(std::byte const* buffer, size_t const buffer_size, uint64_t& val) {
+  size_t const num_bytes = from_varint(buffer, buffer_size, val);
+  checkCond(num_bytes != 0, "truncated or invalid varint");
+  return num_bytes;
+}
+
+/**
+ * Integer serialized as a varint, e.g. for counters that are mostly small
+ */
+template <std::integral T>
+  requires (not std::is_same_v<T, bool>)
+struct varint {
+  T value{};
+
+  constexpr varint() = default;
+  constexpr varint(T val) : value(val) {}
+  constexpr operator T() const { return value; }
+  constexpr auto operator<=>(varint const&) const = default;
+
+  static constexpr uint64_t encode(T const val) {
+    if constexpr (std::is_signed_v<T>) {
+      return zigzag_encode(val);
+    } else {
+      return val;
+    }
+  }
+
+  static constexpr T decode(uint64_t const val) {
+    if constexpr (std::is_signed_v<T>) {
+      return static_cast<T>(zigzag_decode(val));
+    } else {
+      return static_cast<T>(val);
+    }
+  }
+};
+
+// variable size, despite being trivially copyable
+template <typename T>
+size_t serial_size(varint<T> const*) = delete;
+
+template <typename T>
+constexpr size_t serial_size(varint<T> const& val) {
+  return varint_size(varint<T>::encode(val.value));
+}
+
+template <typename T>
+constexpr size_t to_bytes(std::byte* buffer, size_t /*buffer_size*/, varint<T> const& val) {
+  return to_varint(buffer, varint<T>::encode(val.value));
+}
+
+template <typename T>
+size_t from_bytes(std::byte const* buffer, size_t buffer_size, varint<T>& val) {
+  uint64_t encoded = 0;
+  size_t const num_bytes = read_varint(buffer, buffer_size, encoded);
+  val.value = varint<T>::decode(encoded);
+  return num_bytes;
+}
+
+/**
+ * std::string or std::vector whose size is serialized as a varint instead of a single byte,
+ * so that it isn't limited to 255 elements. Sizes below 128 take a single byte either way.
+ * e.g. varint_sized<std::vector<int>> values;
+ */
+template <typename Container>
+struct varint_sized : Container {
+  using Container::Container;
+  constexpr varint_sized() = default;
+  constexpr varint_sized(Container const& val) : Container(val) {}
+  constexpr varint_sized(Container&& val) : Container(std::move(val)) {}
+};
+
+template <typename Container>
+constexpr size_t serial_size(varint_sized<Container> const& val) {
+  size_t num_bytes = varint_size(val.size());
+  if constexpr (std::is_same_v<Container, std::string>) {
+    num_bytes += val.size();
+  } else {
+    for (auto& item : val) {
+      num_bytes += serial_size(item);
+    }
+  }
+  return num_bytes;
+}
+
+template <typename Container>
+size_t to_bytes(std::byte* buffer, size_t buffer_size, varint_sized<Container> const& val) {
+  size_t num_bytes = to_varint(buffer, val.size());
+  if constexpr (std::is_same_v<Container, std::string>) {
+    std::memcpy(buffer + num_bytes, val.data(), val.size());
+    num_bytes += val.size();
+  } else {
+    for (auto& item : val) {
+      num_bytes += to_bytes(buffer + num_bytes, buffer_size - num_bytes, item);
+    }
+  }
+  return num_bytes;
+}
+
+template <typename Container>
+size_t from_bytes(std::byte const* buffer, size_t buffer_size, varint_sized<Container>& val) {
+  uint64_t size = 0;
+  size_t num_bytes = read_varint(buffer, buffer_size, size);
+  // every element takes at least one byte: guards against allocating for a corrupted size
+  checkCond(size <= buffer_size - num_bytes, "serialized size exceeds buffer:", size, ">", buffer_size - num_bytes);
+  if constexpr (std::is_same_v<Container, std::string>) {
+    val.resize(size);
+    std::memcpy(val.data(), buffer + num_bytes, size);
+    num_bytes += size;
+  } else {
+    val.resize(size);
+    for (auto& item : val) {
+      num_bytes += from_bytes(buffer + num_bytes, buffer_size - num_bytes, item);
+    }
+  }
+  return num_bytes;
+}
+
+/**
+ * Checked serialization: try_to_bytes / try_from_bytes validate the remaining space before every write or read,
+ * and report failures as a serial_result instead of throwing, e.g. for parsing untrusted, possibly truncated packets.
+ * Note: only deserialization of std::string and std::vector may allocate (for the deserialized value).
+ * Their size prefix gets checked against the remaining input first, so that a corrupt one can't request
+ * more than the input could hold.
+ */
+enum class serial_error : uint8_t {
+  none,
+  buffer_too_small,   // serialization: not enough room in the output buffer
+  truncated_data,     // deserialization: the input ends before the value does
+  invalid_data,       // value can't be represented (e.g. size over 255 with a 1 byte size prefix, invalid varint)
+  allocation_failed,  // deserialization: the deserialized std::string or std::vector couldn't be resized
+};
+
+struct serial_result {
+  size_t num_bytes = 0;  // number of bytes written or read, valid only in the absence of error
+  serial_error error = serial_error::none;
+
+  [[nodiscard]] constexpr bool has_value() const { return error == serial_error::none; }
+  constexpr explicit operator bool() const { return has_value(); }
+  [[nodiscard]] constexpr size_t operator*() const { return num_bytes; }
+  constexpr bool operator==(serial_result const&) const = default;
+};
+
+namespace details {
+// whether the remaining input can hold num_items serialized T, checked before allocating for them
+template <typename T>
+constexpr bool can_hold(size_t const remaining_size, uint64_t const num_items) {
+  if constexpr (fixed_serial_size<T>) {
+    constexpr size_t item_size = fixed_serial_size_v<T>;
+    return item_size == 0 or num_items <= remaining_size / item_size;
+  } else {
+    // variable size values take at least one byte
+    return num_items <= remaining_size;
+  }
+}
+
+template <typename Container>
+bool try_resize(Container& container, size_t const size) noexcept {
+  try {
+    container.resize(size);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+}  // namespace details
+
+template <typename T>
+serial_result try_to_bytes(std::byte* buffer, size_t buffer_size, T const& val) noexcept;
+template <typename T>
+serial_result try_to_bytes(std::byte* buffer, size_t buffer_size, std::vector<T> const& val) noexcept;
+template <typename T>
+  requires fixed_serial_size<T>
+serial_result try_from_bytes(std::byte const* buffer, size_t buffer_size, T& val) noexcept;
+template <typename T>
+serial_result try_from_bytes(std::byte const* buffer, size_t buffer_size, std::vector<T>& val) noexcept;
+
+template <typename T>
+serial_result try_to_bytes(std::byte* buffer, size_t const buffer_size, T const& val) noexcept {
+  size_t const num_bytes = serial_size(val);
+  if (num_bytes > buffer_size) {
+    return {0, serial_error::buffer_too_small};
+  }
+  return {to_bytes(buffer, buffer_size, val)};
+}
+
+inline serial_result try_to_bytes(std::byte* buffer, size_t const buffer_size, std::string const& val) noexcept {
+  if (val.size() > 0xFF) {
+    return {0, serial_error::invalid_data};
+  }
+  if (1 + val.size() > buffer_size) {
+    return {0, serial_error::buffer_too_small};
+  }
+  return {to_bytes(buffer, buffer_size, val)};
+}
+
+template <typename T>
+serial_result try_to_bytes(std::byte* buffer, size_t const buffer_size, std::vector<T> const& val) noexcept {
+  if (val.size() > 0xFF) {
+    return {0, serial_error::invalid_data};
+  }
+  if (buffer_size < 1) {
+    return {0, serial_error::buffer_too_small};
+  }
+  buffer[0] = static_cast<std::byte>(val.size());
+  size_t num_bytes = 1;
+  for (auto& item : val) {
+    auto const res = try_to_bytes(buffer + num_bytes, buffer_size - num_bytes, item);
+    if (not res) {
+      return res;
+    }
+    num_bytes += res.num_bytes;
+  }
+  return {num_bytes};
+}
+
+template <typename T>
+  requires fixed_serial_size<T>
+serial_result try_from_bytes(std::byte const* buffer, size_t const buffer_size, T& val) noexcept {
+  if (serial_size(static_cast<T const*>(nullptr)) > buffer_size) {
+    return {0, serial_error::truncated_data};
+  }
+  return {from_bytes(buffer, buffer_size, val)};
+}
+
+inline serial_result try_from_bytes(std::byte const* buffer, size_t const buffer_size, std::string& val) noexcept {
+  if (buffer_size < 1 or 1 + std::to_integer<size_t>(buffer[0]) > buffer_size) {
+    return {0, serial_error::truncated_data};
+  }
+  size_t const str_size = std::to_integer<size_t>(buffer[0]);
+  if (not details::try_resize(val, str_size)) {
+    return {0, serial_error::allocation_failed};
+  }
+  std::memcpy(val.data(), buffer + 1, str_size);
+  return {str_size + 1};
+}
+
+template <typename T>
+serial_result try_from_bytes(std::byte const* buffer, size_t const buffer_size, std::vector<T>& val) noexcept {
+  if (buffer_size < 1 or not details::can_hold<T>(buffer_size - 1, std::to_integer<size_t>(buffer[0]))) {
+    return {0, serial_error::truncated_data};
+  }
+  if (not details::try_resize(val, std::to_integer<size_t>(buffer[0]))) {
+    return {0, serial_error::allocation_failed};
+  }
+  size_t num_bytes = 1;
+  for (auto& item : val) {
+    auto const res = try_from_bytes(buffer + num_bytes, buffer_size - num_bytes, item);
+    if (not res) {
+      return res;
+    }
+    num_bytes += res.num_bytes;
+  }
+  return {num_bytes};
+}
+
+template <typename T>
+serial_result try_from_bytes(std::byte const* buffer, size_t const buffer_size, varint<T>& val) noexcept {
+  uint64_t encoded = 0;
+  size_t const num_bytes = from_varint(buffer, buffer_size, encoded);
+  if (num_bytes == 0) {
+    return {0, buffer_size < (64 + 6) / 7 ? serial_error::truncated_data : serial_error::invalid_data};
+  }
+  val.value = varint<T>::decode(encoded);
+  return {num_bytes};
+}
+
+template <typename Container>
+serial_result try_from_bytes(std::byte const* buffer, size_t const buffer_size, varint_sized<Container>& val) noexcept {
+  uint64_t size = 0;
+  size_t num_bytes = from_varint(buffer, buffer_size, size);
+  if (num_bytes == 0 or not details::can_hold<typename Container::value_type>(buffer_size - num_bytes, size)) {
+    return {0, serial_error::truncated_data};
+  }
+  if (not details::try_resize(val, size)) {
+    return {0, serial_error::allocation_failed};
+  }
+  if constexpr (std::is_same_v<Container, std::string>) {
+    std::memcpy(val.data(), buffer + num_bytes, size);
+    num_bytes += size;
+  } else {
+    for (auto& item : val) {
+      auto const res = try_from_bytes(buffer + num_bytes, buffer_size - num_bytes, item);
+      if (not res) {
+        return res;
+      }
+      num_bytes += res.num_bytes;
+    }
+  }
+  return {num_bytes};
+}
 }  // namespace app_utils::serial
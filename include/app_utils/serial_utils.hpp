@@ -21,11 +21,55 @@ size_t to_bytes(std::byte* data, size_t len, T1 const& val1, T2 const& val2, T c
   return num_written;
 }
 
+// stops at the first error
+template<typename T1, typename T2, typename ...T>
+serial_result try_from_bytes(std::byte const* data, size_t len, T1& val1, T2& val2, T&... val) noexcept {
+  serial_result res = try_from_bytes(data, len, val1);
+  auto const read_next = [&](auto& next) {
+    if (res) {
+      auto const next_res = try_from_bytes(data + res.num_bytes, len - res.num_bytes, next);
+      res = next_res ? serial_result{res.num_bytes + next_res.num_bytes} : next_res;
+    }
+  };
+  read_next(val2);
+  (read_next(val), ...);
+  return res;
+}
+
+template<typename T1, typename T2, typename ...T>
+serial_result try_to_bytes(std::byte* data, size_t len, T1 const& val1, T2 const& val2, T const&... val) noexcept {
+  serial_result res = try_to_bytes(data, len, val1);
+  auto const write_next = [&](auto const& next) {
+    if (res) {
+      auto const next_res = try_to_bytes(data + res.num_bytes, len - res.num_bytes, next);
+      res = next_res ? serial_result{res.num_bytes + next_res.num_bytes} : next_res;
+    }
+  };
+  write_next(val2);
+  (write_next(val), ...);
+  return res;
+}
+
+template<typename T>
+serial_result try_from_bytes(std::span<std::byte const> bytes, T& val) noexcept {
+  return try_from_bytes(bytes.data(), bytes.size(), val);
+}
+
 template<typename T>
 size_t from_bytes(std::span<std::byte const> bytes, T& val) {
   return from_bytes(bytes.data(), bytes.size(), val);
 }
 
+// serialization into a stack buffer, for fixed serial size types
+template<typename ...T>
+  requires (fixed_serial_size<T> and ...)
+constexpr static_buffer_t<T...> make_static_buffer(T const&... val) {
+  static_buffer_t<T...> bytes;
+  size_t num_written = 0;
+  ((num_written += to_bytes(bytes.data() + num_written, bytes.size() - num_written, val)), ...);
+  return bytes;
+}
+
 template<typename T>
 size_t to_bytes(std::vector<std::byte>& bytes, T const& val) {
   bytes.resize(serial_size(val));
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace app_utils {
+
+/**
+ * Wait-free single producer / single consumer counterpart of circular_array_t,
+ * to hand over values from one thread to another without a mutex.
+ * - try_push / try_push_n may only be called from the producer thread
+ * - try_pop / try_pop_n may only be called from the consumer thread
+ * Contrary to circular_array_t, a full buffer does not overwrite its oldest entries: pushes fail instead.
+ * Head and tail indices live on separate cache lines, along with the copy of the other index
+ * that each side keeps, so that the producer and the consumer only share a cache line when the cached copy is stale.
+ */
+template <typename T, size_t capacity_>
+class spsc_circular_array_t {
+  static_assert(std::has_single_bit(capacity_), "capacity must be a power of 2");
+  static_assert(std::atomic<size_t>::is_always_lock_free);
+
+  static constexpr size_t cache_line_size = 64;
+  static constexpr size_t index_mask = capacity_ - 1;
+
+  // indices increase monotonically (and wrap around with size_t), and are masked to address the slots
+
+  // consumer side
+  alignas(cache_line_size) std::atomic<size_t> m_head{0};  // next slot to pop
+  size_t m_cached_tail = 0;
+  // producer side
+  alignas(cache_line_size) std::atomic<size_t> m_tail{0};  // next slot to push
+  size_t m_cached_head = 0;
+
+  alignas(cache_line_size) std::array<T, capacity_> m_array;
+
+  // copies the values to / from the slots starting at index, in (up to) two contiguous segments
+  void copy_to_slots(size_t const index, std::span<T const> values) {
+    size_t const offset = index & index_mask;
+    size_t const first_size = std::min(values.size(), capacity_ - offset);
+    std::copy_n(values.begin(), first_size, m_array.begin() + offset);
+    std::copy(values.begin() + first_size, values.end(), m_array.begin());
+  }
+
+  void copy_from_slots(size_t const index, std::span<T> values) const {
+    size_t const offset = index & index_mask;
+    size_t const first_size = std::min(values.size(), capacity_ - offset);
+    std::copy_n(m_array.begin() + offset, first_size, values.begin());
+    std::copy_n(m_array.begin(), values.size() - first_size, values.begin() + first_size);
+  }
+
+  // number of free slots as seen from the producer, refreshing the cached head only when needed
+  size_t free_slots(size_t const tail, size_t const num_wanted) {
+    if (capacity_ - (tail - m_cached_head) < num_wanted) {
+      m_cached_head = m_head.load(std::memory_order_acquire);
+    }
+    return capacity_ - (tail - m_cached_head);
+  }
+
+  // number of available values as seen from the consumer, refreshing the cached tail only when needed
+  size_t available_values(size_t const head, size_t const num_wanted) {
+    if (m_cached_tail - head < num_wanted) {
+      m_cached_tail = m_tail.load(std::memory_order_acquire);
+    }
+    return m_cached_tail - head;
+  }
+
+ public:
+  static constexpr size_t capacity() { return capacity_; }
+
+  // approximate when called while the other thread is pushing or popping
+  [[nodiscard]]
+  size_t size() const {
+    // head first: the consumer only moves head up to a tail it has seen, so the tail loaded after it isn't behind it
+    size_t const head = m_head.load(std::memory_order_acquire);
+    size_t const tail = m_tail.load(std::memory_order_acquire);
+    size_t const size = tail - head;
+    // clamped all the same, as a wrapped around difference would make an empty buffer look full
+    return size <= capacity_ ? size : 0;
+  }
+
+  [[nodiscard]]
+  bool empty() const { return size() == 0; }
+
+  // producer side. returns false if the buffer is full
+  template <typename U>
+  bool try_push(U&& value) {
+    size_t const tail = m_tail.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0) {
+      return false;
+    }
+    m_array[tail & index_mask] = std::forward<U>(value);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // producer side. pushes as many values as there are free slots, returns the number of pushed values
+  size_t try_push_n(std::span<T const> values) {
+    size_t const tail = m_tail.load(std::memory_order_relaxed);
+    size_t const num_values = std::min(values.size(), free_slots(tail, values.size()));
+    if (num_values > 0) {
+      copy_to_slots(tail, values.first(num_values));
+      m_tail.store(tail + num_values, std::memory_order_release);
+    }
+    return num_values;
+  }
+
+  // consumer side. returns false if the buffer is empty
+  bool try_pop(T& value) {
+    size_t const head = m_head.load(std::memory_order_relaxed);
+    if (available_values(head, 1) == 0) {
+      return false;
+    }
+    value = std::move(m_array[head & index_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer side. pops up to values.size() values, returns the number of popped values
+  size_t try_pop_n(std::span<T> values) {
+    size_t const head = m_head.load(std::memory_order_relaxed);
+    size_t const num_values = std::min(values.size(), available_values(head, values.size()));
+    if (num_values > 0) {
+      copy_from_slots(head, values.first(num_values));
+      m_head.store(head + num_values, std::memory_order_release);
+    }
+    return num_values;
+  }
+};
+}  // namespace app_utils
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include "string_utils.hpp"
+
+namespace yaml_utils {
+
+struct yaml_line_t {
+  std::string_view raw;      // without the end of line
+  std::string_view content;  // stripped of the indentation and of trailing whitespace
+  size_t indent = 0;         // in number of indentation levels
+  int line_num = 0;
+  size_t end_pos = 0;        // position of the next line in the text
+};
+
+/**
+ * Single pass reader of yaml lines over in-memory text (e.g. a std::string or a memory mapped file),
+ * with no copy of the lines: parsers peek at the next line and only consume it if it belongs to them.
+ */
+class yaml_reader {
+  std::string_view m_text;
+  size_t m_pos = 0;
+  int m_line_num;
+
+ public:
+  explicit yaml_reader(std::string_view text, int line_offset = 0)
+    : m_text(text)
+    , m_line_num(line_offset) {}
+
+  // position of the first character not consumed yet
+  [[nodiscard]] size_t position() const { return m_pos; }
+  [[nodiscard]] bool at_end() const { return m_pos >= m_text.size(); }
+
+  bool peek(yaml_line_t& line) const {
+    if (at_end()) {
+      return false;
+    }
+    size_t end_of_line = m_text.find('\n', m_pos);
+    line.end_pos = end_of_line == std::string_view::npos ? m_text.size() : end_of_line + 1;
+    end_of_line = std::min(end_of_line, m_text.size());
+    line.raw = m_text.substr(m_pos, end_of_line - m_pos);
+    if (not line.raw.empty() and line.raw.back() == '\r') {
+      line.raw.remove_suffix(1);
+    }
+    size_t const first_char = line.raw.find_first_not_of(' ');
+    line.indent = first_char == std::string_view::npos ? 0 : first_char / indent_width;
+    line.content = app_utils::strutils::strip(line.raw);
+    line.line_num = m_line_num + 1;
+    return true;
+  }
+
+  void consume(yaml_line_t const& line) {
+    m_pos = line.end_pos;
+    m_line_num = line.line_num;
+  }
+};
+
+namespace details {
+template <typename Func>
+bool for_each_item(std::string_view str, Func&& func) {
+  str = app_utils::strutils::strip(str);
+  if (str.starts_with('[') and str.ends_with(']')) {
+    str = str.substr(1, str.size() - 2);
+  }
+  if (app_utils::strutils::strip(str).empty()) {
+    return true;
+  }
+  while (true) {
+    size_t const comma_pos = str.find(',');
+    if (not func(app_utils::strutils::strip(str.substr(0, comma_pos)))) {
+      return false;
+    }
+    if (comma_pos == std::string_view::npos) {
+      return true;
+    }
+    str.remove_prefix(comma_pos + 1);
+  }
+}
+}  // namespace details
+
+/**
+ * Parses a single-line value, with std::from_chars for numbers and no intermediate string.
+ * Other types defer to from_string.
+ * returns false if str isn't a valid value.
+ */
+template <typename T>
+bool parse_value(T& val, std::string_view str) {
+  if constexpr (std::is_same_v<T, bool>) {
+    if (str == "true" or str == "1") {
+      val = true;
+    } else if (str == "false" or str == "0") {
+      val = false;
+    } else {
+      return false;
+    }
+    return true;
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    if (str.starts_with('+')) {
+      str.remove_prefix(1);
+    }
+    auto const [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+    return ec == std::errc{} and ptr == str.data() + str.size();
+  } else {
+    using namespace app_utils::strutils;
+    return from_string(val, str);
+  }
+}
+
+template <typename T, size_t N>
+bool parse_value(std::array<T, N>& val, std::string_view str) {
+  if constexpr (std::is_same_v<T, char>) {
+    using namespace app_utils::strutils;
+    return from_string(val, str);
+  } else {
+    size_t num_items = 0;
+    return details::for_each_item(str, [&](std::string_view item) {
+             return num_items < N and parse_value(val[num_items++], item);
+           }) and num_items == N;
+  }
+}
+
+template <typename T>
+bool parse_value(std::vector<T>& val, std::string_view str) {
+  val.clear();
+  return details::for_each_item(str, [&](std::string_view item) {
+    T item_val{};
+    if (not parse_value(item_val, item)) {
+      return false;
+    }
+    val.push_back(item_val);
+    return true;
+  });
+}
+
+}  // namespace yaml_utils
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "string_utils.hpp"
+#include "yaml_utils.hpp"
+
+namespace yaml_utils {
+
+/**
+ * Formats yaml straight into a caller provided std::string, which keeps its capacity across uses when cleared,
+ * with std::to_chars for numbers: no ostream, no locale, no temporary string for the common value types.
+ * Produces the same text as the ostream based to_yaml.
+ * Custom types hook in with a write_yaml(yaml_writer&, T const&) overload found by ADL,
+ * and otherwise go through app_utils::strutils::to_string.
+ */
+class yaml_writer {
+  std::string& m_out;
+  int m_depth = -1;
+
+  template <typename T>
+  void append_number(T const val) {
+    std::array<char, 32> chars;
+    std::to_chars_result res;
+    if constexpr (std::is_floating_point_v<T>) {
+      // same as an ostream with std::setprecision(8), see strutils::to_string(double)
+      res = std::to_chars(chars.data(), chars.data() + chars.size(), val, std::chars_format::general, 8);
+    } else {
+      res = std::to_chars(chars.data(), chars.data() + chars.size(), val);
+    }
+    m_out.append(chars.data(), res.ptr);
+  }
+
+  template <typename Range>
+  void append_sequence(Range const& vals) {
+    m_out += '[';
+    bool first = true;
+    for (auto const& val : vals) {
+      if (not first) {
+        m_out += ", ";
+      }
+      first = false;
+      write(static_cast<typename Range::value_type const&>(val));
+    }
+    m_out += ']';
+  }
+
+ public:
+  explicit yaml_writer(std::string& out)
+    : m_out(out) {}
+
+  [[nodiscard]] std::string& out() { return m_out; }
+
+  // nesting depth of the reflexio struct being written, 0 at the top level
+  [[nodiscard]] int depth() const { return m_depth; }
+
+  struct nested_scope_t {
+    yaml_writer& writer;
+    explicit nested_scope_t(yaml_writer& writer_) : writer(writer_) { writer.m_depth++; }
+    ~nested_scope_t() { writer.m_depth--; }
+    nested_scope_t(nested_scope_t const&) = delete;
+    nested_scope_t& operator=(nested_scope_t const&) = delete;
+  };
+
+  [[nodiscard]] nested_scope_t enter_nested() { return nested_scope_t{*this}; }
+
+  void indent() {
+    for (int i = 0; i < m_depth; i++) {
+      m_out += indent_str;
+    }
+  }
+
+  yaml_writer& append(std::string_view const str) {
+    m_out += str;
+    return *this;
+  }
+
+  yaml_writer& append(char const c) {
+    m_out += c;
+    return *this;
+  }
+
+  // writes a value
+  template <typename T>
+  yaml_writer& write(T const& val) {
+    if constexpr (requires { write_yaml(*this, val); }) {
+      write_yaml(*this, val);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      m_out += val ? "true" : "false";
+    } else if constexpr (std::is_arithmetic_v<T> and not std::is_same_v<T, char>) {
+      append_number(val);
+    } else if constexpr (std::is_enum_v<T> and requires { { to_string(val) } -> std::convertible_to<std::string_view>; }) {
+      m_out += std::string_view{to_string(val)};
+    } else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+      m_out += std::string_view{val};
+    } else {
+      using namespace app_utils::strutils;
+      m_out += to_string(val);
+    }
+    return *this;
+  }
+
+  template <typename T, size_t N>
+  yaml_writer& write(std::array<T, N> const& val) {
+    if constexpr (std::is_same_v<T, char>) {
+      m_out.append(val.data(), std::min(N, std::strlen(val.data())));
+    } else {
+      append_sequence(val);
+    }
+    return *this;
+  }
+
+  template <typename T>
+  yaml_writer& write(std::vector<T> const& val) {
+    if constexpr (std::is_same_v<T, char>) {
+      m_out.append(val.data(), val.size());
+    } else {
+      append_sequence(val);
+    }
+    return *this;
+  }
+
+  template <size_t N>
+  yaml_writer& write(std::bitset<N> const& val) {
+    // note the convention: left to right, as strutils::to_string
+    for (size_t i = 0; i < N; i++) {
+      m_out += val.test(N - 1 - i) ? '1' : '0';
+    }
+    return *this;
+  }
+};
+
+}  // namespace yaml_utils
@@ -1,6 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <app_utils/circular_array.hpp>
+#include <app_utils/spsc_circular_array.hpp>
+
+#include <numeric>
+#include <thread>
+#include <vector>
 
 TEST_CASE("circular_array", "[container]") {
 
@@ -49,3 +54,111 @@ TEST_CASE("circular_array", "[container]") {
   REQUIRE(test_vec[1] == 3);
   REQUIRE(test_vec[2] == 4);
 }
+
+TEST_CASE("circular_array_power_of_two", "[container]") {
+  app_utils::circular_array_t<int, 4> buffer;
+  for (int i = 1; i <= 10; i++) {
+    buffer.get_next_slot() = i;
+  }
+  REQUIRE(buffer.size() == 4);
+  REQUIRE(buffer.front() == 7);
+  REQUIRE(buffer.back() == 10);
+  std::vector<int> test_vec;
+  for (auto& item : buffer) {
+    test_vec.push_back(item);
+  }
+  REQUIRE(test_vec == std::vector<int>{7, 8, 9, 10});
+}
+
+TEST_CASE("circular_array_spans", "[container]") {
+  auto to_vector = [](auto const& spans) {
+    std::vector<int> res(spans[0].begin(), spans[0].end());
+    res.insert(res.end(), spans[1].begin(), spans[1].end());
+    return res;
+  };
+
+  app_utils::circular_array_t<int, 5> buffer;
+  app_utils::circular_array_t<int, 5> reference_buffer;
+  REQUIRE(to_vector(buffer.as_spans()).empty());
+
+  std::vector<int> values(13);
+  std::iota(values.begin(), values.end(), 1);
+  size_t offset = 0;
+  for (size_t num_values : {2, 2, 3, 0, 6}) {
+    std::span<int const> const chunk = std::span<int const>{values}.subspan(offset, num_values);
+    offset += num_values;
+    buffer.push_back_range(chunk);
+    for (int val : chunk) {
+      reference_buffer.get_next_slot() = val;
+    }
+    REQUIRE(buffer.size() == reference_buffer.size());
+    std::vector<int> reference;
+    for (int val : reference_buffer) {
+      reference.push_back(val);
+    }
+    REQUIRE(to_vector(buffer.as_spans()) == reference);
+    REQUIRE(buffer.front() == reference_buffer.front());
+    REQUIRE(buffer.back() == reference_buffer.back());
+  }
+  REQUIRE(buffer.as_spans()[0].size() == 2);
+  REQUIRE(to_vector(buffer.as_spans()) == std::vector<int>{9, 10, 11, 12, 13});
+}
+
+TEST_CASE("spsc_circular_array", "[container]") {
+  app_utils::spsc_circular_array_t<int, 4> buffer;
+  REQUIRE(buffer.capacity() == 4);
+  REQUIRE(buffer.empty());
+
+  int val = 0;
+  REQUIRE(not buffer.try_pop(val));
+  REQUIRE(buffer.try_push(1));
+  REQUIRE(buffer.try_push(2));
+  REQUIRE(buffer.size() == 2);
+  REQUIRE(buffer.try_pop(val));
+  REQUIRE(val == 1);
+
+  // bulk push wrapping around, limited by the free slots
+  std::array<int, 5> const values = {3, 4, 5, 6, 7};
+  REQUIRE(buffer.try_push_n(values) == 3);
+  REQUIRE(buffer.size() == 4);
+  REQUIRE(not buffer.try_push(8));
+
+  std::array<int, 8> popped{};
+  REQUIRE(buffer.try_pop_n(popped) == 4);
+  REQUIRE(std::vector<int>(popped.begin(), popped.begin() + 4) == std::vector<int>{2, 3, 4, 5});
+  REQUIRE(buffer.empty());
+  REQUIRE(buffer.try_pop_n(popped) == 0);
+
+  // one producer thread, one consumer thread
+  app_utils::spsc_circular_array_t<int, 64> queue;
+  constexpr int num_values = 100000;
+  std::thread producer([&] {
+    std::array<int, 7> chunk;
+    int next = 0;
+    while (next < num_values) {
+      size_t const chunk_size = std::min<size_t>(chunk.size(), num_values - next);
+      for (size_t i = 0; i < chunk_size; i++) {
+        chunk[i] = next + int(i);
+      }
+      size_t num_pushed = 0;
+      while (num_pushed < chunk_size) {
+        num_pushed += queue.try_push_n(std::span<int const>{chunk}.subspan(num_pushed, chunk_size - num_pushed));
+      }
+      next += int(chunk_size);
+    }
+  });
+
+  std::vector<int> received;
+  std::array<int, 5> chunk;
+  while (received.size() < num_values) {
+    size_t const num_popped = queue.try_pop_n(chunk);
+    received.insert(received.end(), chunk.begin(), chunk.begin() + num_popped);
+  }
+  producer.join();
+  REQUIRE(queue.empty());
+  bool in_order = true;
+  for (int i = 0; i < num_values; i++) {
+    in_order = in_order and received[i] == i;
+  }
+  REQUIRE(in_order);
+}
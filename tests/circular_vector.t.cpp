@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <app_utils/circular_vector.hpp>
+#include <app_utils/mpmc_circular_vector.hpp>
+
+#include <numeric>
+#include <thread>
 
 #include <type_traits>
 
@@ -132,4 +136,130 @@ TEST_CASE("circular_vector", "[container]") {
   REQUIRE(buff2.empty());
   REQUIRE(buff2.get_front_index() == 0);
   REQUIRE(buff2.get_back_index() == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("circular_vector_power_of_two", "[container]") {
+  REQUIRE_THROWS(circular_vector_t<int, true>(3));
+
+  circular_vector_t<int, true> buff(4);
+  circular_vector_t<int> reference_buff(4);
+  for (int i = 1; i <= 10; i++) {
+    buff.push_back(i);
+    reference_buff.push_back(i);
+    REQUIRE(buff.size() == reference_buff.size());
+    REQUIRE(buff.front() == reference_buff.front());
+    REQUIRE(buff.back() == reference_buff.back());
+    for (size_t j = 0; j < buff.size(); j++) {
+      REQUIRE(buff[j] == reference_buff[j]);
+    }
+  }
+  REQUIRE(std::vector<int>(buff.begin(), buff.end()) == std::vector<int>{7, 8, 9, 10});
+  buff.pop_front(2);
+  REQUIRE(buff.front() == 9);
+  REQUIRE(buff.at(1) == 10);
+
+  REQUIRE_THROWS(buff.reset(6));
+  buff.reset(8);
+  REQUIRE(buff.capacity() == 8);
+  REQUIRE(buff.empty());
+}
+
+TEST_CASE("circular_vector_spans", "[container]") {
+  auto to_vector = [](auto const& spans) {
+    std::vector<int> res(spans[0].begin(), spans[0].end());
+    res.insert(res.end(), spans[1].begin(), spans[1].end());
+    return res;
+  };
+
+  circular_vector_t<int> buff(5);
+  circular_vector_t<int> reference_buff(5);
+  REQUIRE(to_vector(buff.as_spans()).empty());
+
+  std::vector<int> values(30);
+  std::iota(values.begin(), values.end(), 1);
+  size_t offset = 0;
+  // (number of values pushed, number of values popped)
+  for (auto [num_pushed, num_popped] : std::vector<std::pair<size_t, size_t>>{
+         {2, 0}, {2, 1}, {3, 0}, {1, 2}, {0, 0}, {6, 0}, {4, 4}, {7, 1}, {1, 5}}) {
+    std::span<int const> const chunk = std::span<int const>{values}.subspan(offset, num_pushed);
+    offset += num_pushed;
+    buff.push_back_range(chunk);
+    for (int val : chunk) {
+      reference_buff.push_back(val);
+    }
+    buff.pop_front(num_popped);
+    reference_buff.pop_front(num_popped);
+    auto const reference = std::vector<int>(reference_buff.begin(), reference_buff.end());
+    REQUIRE(to_vector(buff.as_spans()) == reference);
+    REQUIRE(std::vector<int>(buff.begin(), buff.end()) == reference);
+    REQUIRE(buff.get_front_index() == reference_buff.get_front_index());
+    REQUIRE(buff.get_back_index() == reference_buff.get_back_index());
+  }
+
+  buff.push_back_range(std::span<int const>{values}.first(7));
+  REQUIRE(buff.has_wrapped_around());
+  REQUIRE(not buff.as_spans()[1].empty());
+  REQUIRE(to_vector(buff.as_spans()) == std::vector<int>{3, 4, 5, 6, 7});
+  buff.pop_front(10);
+  REQUIRE(buff.empty());
+}
+
+TEST_CASE("mpmc_circular_vector", "[container]") {
+  mpmc_circular_vector_t<int> queue(3);
+  REQUIRE(queue.capacity() == 4);
+  REQUIRE(queue.empty());
+
+  int val = 0;
+  REQUIRE(not queue.try_pop(val));
+  for (int i = 0; i < 4; i++) {
+    REQUIRE(queue.try_push(i));
+  }
+  REQUIRE(queue.size() == 4);
+  REQUIRE(not queue.try_push(4));
+  REQUIRE(not queue.try_push_for(4, std::chrono::milliseconds(1)));
+  for (int i = 0; i < 4; i++) {
+    REQUIRE(queue.try_pop(val));
+    REQUIRE(val == i);
+  }
+  REQUIRE(not queue.try_pop_for(val, std::chrono::milliseconds(1)));
+
+  // a stop request releases a blocked consumer
+  std::stop_source stop_source;
+  bool popped_value = true;
+  std::thread consumer([&] { popped_value = queue.pop(val, stop_source.get_token()); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  stop_source.request_stop();
+  consumer.join();
+  REQUIRE(not popped_value);
+
+  // several producers and consumers
+  mpmc_circular_vector_t<int> shared_queue(64);
+  constexpr int num_threads = 4;
+  constexpr int num_values_per_producer = 20000;
+  std::atomic<long> sum = 0;
+  std::atomic<int> num_popped = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&] {
+      for (int i = 1; i <= num_values_per_producer; i++) {
+        shared_queue.push(i);
+      }
+    });
+    threads.emplace_back([&] {
+      // consumers stop once all the values got popped, however slow the producers are
+      int popped;
+      while (num_popped < num_threads * num_values_per_producer) {
+        if (shared_queue.try_pop_for(popped, std::chrono::milliseconds(10))) {
+          sum += popped;
+          num_popped++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(num_popped == num_threads * num_values_per_producer);
+  REQUIRE(sum == long(num_threads) * num_values_per_producer * (num_values_per_producer + 1) / 2);
+  REQUIRE(shared_queue.empty());
+}
@@ -6,6 +6,12 @@
 #include <app_utils/serial_type_utils.hpp>
 #include <app_utils/serial_utils.hpp>
 #include <app_utils/log_utils.hpp>
+#include <app_utils/reflexio_wire_view.hpp>
+#include <app_utils/reflexio_record_file.hpp>
+#include <app_utils/reflexio_soa_vector.hpp>
+#include <app_utils/reflexio_tagged.hpp>
+#include <app_utils/reflexio_delta.hpp>
+#include <app_utils/reflexio_stream_decoder.hpp>
 #include <fstream>
 #include <filesystem>
 
@@ -56,6 +62,25 @@ TEST_CASE("reflexio_mask", "[reflexio]") {
   auto mask_var_all = TrivialStruct::make_vars_mask(&TrivialStruct::var1,
                                                     &TrivialStruct::var2);
   REQUIRE(mask_var_all == TrivialStruct::Mask{});
+
+  static_assert(TrivialStruct::index_of_var(&TrivialStruct::var2) == 1);
+  static_assert(MyStruct::index_of_var<&MyStruct::var5>() == 4);
+  static_assert(MyStruct::find_index_of_var(&MyStruct::normal_member) == MyStruct::NumMemberVars);
+  static_assert(MyStruct::strictly_increasing(&MyStruct::var1, &MyStruct::var3, &MyStruct::var5));
+  static_assert(not MyStruct::strictly_increasing(&MyStruct::var3, &MyStruct::var1));
+
+  constexpr auto mask_var1_ct = TrivialStruct::make_vars_mask<&TrivialStruct::var1>();
+  REQUIRE(mask_var1_ct == mask_var1);
+  constexpr auto mask_var_all_ct = TrivialStruct::make_vars_mask<&TrivialStruct::var1, &TrivialStruct::var2>();
+  REQUIRE(mask_var_all_ct == mask_var_all);
+  REQUIRE(MyStruct::make_vars_mask<&MyStruct::var2, &MyStruct::var5>() ==
+          MyStruct::make_vars_mask(&MyStruct::var2, &MyStruct::var5));
+
+  TrivialStruct::Mask mask;
+  reflexio::set(mask, &TrivialStruct::var2);
+  REQUIRE(mask == mask_var1);
+  REQUIRE(reflexio::test(mask, &TrivialStruct::var2));
+  REQUIRE(not reflexio::test(mask, &TrivialStruct::var1));
 }
 
 TEST_CASE("reflexio_declare", "[reflexio]") {
@@ -142,6 +167,115 @@ TEST_CASE("reflexio_serialize", "[reflexio]") {
   }
 }
 
+REFLEXIO_STRUCT_DEFINE(PackedNestedStruct,
+  REFLEXIO_MEMBER_VAR_DEFINE(double, var1, 1.5, "var1 doc");
+  REFLEXIO_MEMBER_VAR_DEFINE(MyOtherStruct, var2, {}, "var2 doc");
+  using Array4_t = std::array<int32_t, 4>;
+  REFLEXIO_MEMBER_VAR_DEFINE(Array4_t, var3, {0}, "var3 doc"););
+
+// memcpy based layouts only when the serialized byte order is the platform one
+static_assert(PackedNestedStruct::has_packed_layout() == not app_utils::serial::serial_needs_byteswap);
+static_assert(not NestedStruct::has_packed_layout());
+static_assert(not MyStruct::has_packed_layout()); // unregistered member variables
+
+TEST_CASE("reflexio_serialize_fast_path", "[reflexio]") {
+
+  // the statically dispatched encoding must match the descriptor based encoding
+  auto check_round_trip = [](auto const& sendStruct) {
+    using StructT = std::remove_cvref_t<decltype(sendStruct)>;
+    std::vector<std::byte> buffer(256);
+    size_t const written_bytes = to_bytes(buffer.data(), buffer.size(), sendStruct);
+    REQUIRE(written_bytes == StructT::get_serial_size());
+
+    std::vector<std::byte> ref_buffer(256);
+    size_t ref_written_bytes = 0;
+    for (auto& descriptor: StructT::get_member_descriptors()) {
+      ref_written_bytes += descriptor->write_to_bytes(ref_buffer.data() + ref_written_bytes,
+                                                      ref_buffer.size() - ref_written_bytes,
+                                                      &sendStruct);
+    }
+    REQUIRE(ref_written_bytes == written_bytes);
+    REQUIRE(ref_buffer == buffer);
+
+    StructT receiveStruct;
+    REQUIRE(receiveStruct != sendStruct);
+    REQUIRE(from_bytes(buffer.data(), written_bytes, receiveStruct) == written_bytes);
+    REQUIRE(receiveStruct == sendStruct);
+
+    using app_utils::serial::serial_error;
+    REQUIRE(app_utils::serial::try_from_bytes(buffer.data(), written_bytes - 1, receiveStruct).error == serial_error::truncated_data);
+    REQUIRE(app_utils::serial::try_to_bytes(buffer.data(), written_bytes - 1, sendStruct).error == serial_error::buffer_too_small);
+  };
+
+  PackedNestedStruct packedStruct;
+  packedStruct.var1 = -2.5;
+  packedStruct.var2.var1 = 7;
+  packedStruct.var2.var2 = 3.25f;
+  packedStruct.var3 = {1, -2, 3, -4};
+  check_round_trip(packedStruct);
+
+  NestedStruct nestedStruct;
+  nestedStruct.field_top = 3;
+  nestedStruct.struct1.var2 = 4.5f;
+  nestedStruct.struct2.var1 = -1;
+  check_round_trip(nestedStruct);
+
+  FancierStruct fancierStruct;
+  fancierStruct.var3 = MyEnum::EnumVal1;
+  fancierStruct.var5 = false;
+  fancierStruct.var6[7] = 2.f;
+  check_round_trip(fancierStruct);
+
+  { // packed struct deserialized from a truncated buffer goes field by field
+    std::vector<std::byte> buffer(serial_size(packedStruct));
+    to_bytes(buffer.data(), buffer.size(), packedStruct);
+    PackedNestedStruct receiveStruct;
+    REQUIRE_THROWS_AS(from_bytes(buffer.data(), sizeof(double), receiveStruct),
+                      reflexio::PartialDeserializationException);
+    REQUIRE(receiveStruct.var1 == packedStruct.var1);
+  }
+}
+
+TEST_CASE("reflexio_wire_view", "[reflexio]") {
+  static_assert(NestedStruct::get_serial_offset<0>() == 0);
+  static_assert(NestedStruct::get_serial_offset<1>() == sizeof(int));
+  static_assert(NestedStruct::get_serial_offset<2>() == sizeof(int) + MyOtherStruct::get_serial_size());
+  static_assert(NestedStruct::get_serial_offset<3>() == NestedStruct::get_serial_size());
+  static_assert(reflexio::details::has_fixed_serial_layout<NestedStruct>());
+  static_assert(not reflexio::details::has_fixed_serial_layout<std::vector<int>>());
+  static_assert(not reflexio::details::has_fixed_serial_layout<std::string>());
+  static_assert(not reflexio::details::has_fixed_serial_layout<std::array<std::string, 2>>());
+  static_assert(reflexio::details::has_fixed_serial_layout<std::array<int, 2>>());
+
+  std::vector<NestedStruct> records(3);
+  // start at an odd offset to exercise unaligned reads
+  std::vector<std::byte> buffer(1 + records.size() * NestedStruct::get_serial_size());
+  std::span<std::byte const> const bytes = std::span{buffer}.subspan(1);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].field_top = static_cast<int>(i);
+    records[i].struct1.var2 = 1.5f * static_cast<float>(i);
+    records[i].struct2.var1 = static_cast<int8_t>(-2 * static_cast<int>(i));
+    size_t const offset = 1 + i * NestedStruct::get_serial_size();
+    to_bytes(buffer.data() + offset, buffer.size() - offset, records[i]);
+  }
+
+  for (size_t i = 0; i < records.size(); i++) {
+    reflexio::wire_view<NestedStruct> view{bytes.subspan(i * NestedStruct::get_serial_size())};
+    REQUIRE(view.bytes().size() == NestedStruct::get_serial_size());
+    REQUIRE(view.get<&NestedStruct::field_top>() == records[i].field_top);
+    REQUIRE(view.get<&NestedStruct::struct1>() == records[i].struct1);
+    REQUIRE(view.view<&NestedStruct::struct2>().get<&TrivialStruct::var1>() == records[i].struct2.var1);
+    REQUIRE(view.view<&NestedStruct::struct1>().get<&MyOtherStruct::var2>() == records[i].struct1.var2);
+    REQUIRE(view.get() == records[i]);
+  }
+
+  REQUIRE_THROWS(reflexio::wire_view<NestedStruct>{bytes.first(NestedStruct::get_serial_size() - 1)});
+  REQUIRE(not reflexio::wire_view<NestedStruct>::try_make(bytes.first(NestedStruct::get_serial_size() - 1)));
+  auto const view = reflexio::wire_view<NestedStruct>::try_make(bytes);
+  REQUIRE(view);
+  REQUIRE(view->get() == records[0]);
+}
+
 TEST_CASE("reflexio_constexpr", "[reflexio]") {
   constexpr TrivialStruct myStruct_const;
 
@@ -181,6 +315,51 @@ TEST_CASE("reflexio_iterator", "[reflexio]") {
   }
 }
 
+TEST_CASE("reflexio_for_each_field", "[reflexio]") {
+  std::vector<std::string_view> names;
+  MyStruct::for_each_field([&]<typename Field>(Field) {
+    REQUIRE(MyStruct::get_member_descriptors()[Field::index] == Field::descriptor);
+    names.push_back(Field::descriptor_impl->get_name());
+  });
+  REQUIRE(names == std::vector<std::string_view>{"var1", "var2", "var3", "var4", "var5"});
+
+  // early exit
+  size_t num_visited = 0;
+  MyStruct::for_each_field([&]<typename Field>(Field) {
+    num_visited++;
+    return not std::is_same_v<typename Field::member_type, float>;
+  });
+  REQUIRE(num_visited == 2);
+
+  MyOtherStruct myStruct;
+  myStruct.visit_fields([](auto, auto& value) { value *= 2; });
+  float sum = 0;
+  std::as_const(myStruct).visit_fields([&](auto, auto const& value) { sum += static_cast<float>(value); });
+  REQUIRE(myStruct.var1 == 24);
+  REQUIRE(sum == 25.f);
+
+  MyOtherStruct otherStruct;
+  REQUIRE(myStruct.differing_members(otherStruct) == std::vector<std::string_view>{"var1", "var2"});
+  REQUIRE(myStruct.matching_fields(otherStruct, MyOtherStruct::make_vars_mask(&MyOtherStruct::var1)) == MyOtherStruct::Mask{2});
+  MyOtherStruct::View{otherStruct, MyOtherStruct::make_vars_mask(&MyOtherStruct::var2)} = myStruct;
+  REQUIRE(otherStruct.var2 == myStruct.var2);
+  REQUIRE(otherStruct.var1 != myStruct.var1);
+  myStruct.set_to_default(MyOtherStruct::make_vars_mask(&MyOtherStruct::var2));
+  REQUIRE(myStruct.non_default_values() == std::vector<std::string_view>{"var1"});
+}
+
+TEST_CASE("reflexio_find_field", "[reflexio]") {
+  static_assert(MyStruct::find_field("var1") == 0);
+  static_assert(MyStruct::find_field("var5") == 4);
+  static_assert(MyStruct::find_field("var6") == MyStruct::NumMemberVars);
+  MyStruct::for_each_field([&]<typename Field>(Field) {
+    REQUIRE(MyStruct::find_field(Field::descriptor_impl->get_name()) == Field::index);
+  });
+  REQUIRE(MyStruct::find_field("") == MyStruct::NumMemberVars);
+  REQUIRE(MyStruct::find_field("var") == MyStruct::NumMemberVars);
+  REQUIRE(NestedStruct::find_field("struct2") == 2);
+}
+
 TEST_CASE("reflexio_get_value", "[reflexio]") {
   MyStruct myStruct;
   auto& descriptors = myStruct.get_member_descriptors();
@@ -329,6 +508,317 @@ TEST_CASE("reflexio_to_yaml_file", "[reflexio]") {
   std::filesystem::remove(file_name);
 }
 
+TEST_CASE("reflexio_record_file", "[reflexio]") {
+
+  static_assert(reflexio::schema_fingerprint<NestedStruct>() == reflexio::schema_fingerprint<NestedStruct>());
+  static_assert(reflexio::schema_fingerprint<NestedStruct>() != reflexio::schema_fingerprint<MyOtherStruct>());
+
+  char const* file_name = "test_output.deleteme.records";
+  std::filesystem::remove(file_name);
+
+  std::vector<NestedStruct> records(5);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].field_top = static_cast<int>(i);
+    records[i].struct1.var2 = 0.5f * static_cast<float>(i);
+  }
+  {
+    reflexio::record_file_writer<NestedStruct> writer(file_name);
+    writer.append(std::span{records}.first(2));
+  }
+  {
+    // appending to an existing file
+    reflexio::record_file_writer<NestedStruct> writer(file_name);
+    writer.append(std::span{records}.subspan(2));
+  }
+  {
+    reflexio::record_file<NestedStruct> const file(file_name);
+    REQUIRE(file.size() == records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+      REQUIRE(file[i] == records[i]);
+      REQUIRE(file.view(i).get<&NestedStruct::field_top>() == records[i].field_top);
+    }
+    REQUIRE_THROWS(file.at(records.size()));
+  }
+
+  // schema mismatch
+  REQUIRE_THROWS(reflexio::record_file<MyOtherStruct>(file_name));
+  REQUIRE_THROWS(reflexio::record_file_writer<MyOtherStruct>(file_name));
+
+  // interrupted write: the partial record gets truncated before appending
+  {
+    std::ofstream partial_record(file_name, std::ios::binary | std::ios::app);
+    partial_record.write("abc", 3);
+  }
+  REQUIRE(reflexio::record_file<NestedStruct>(file_name).size() == records.size());
+  {
+    reflexio::record_file_writer<NestedStruct> writer(file_name);
+    writer.append(records[1]);
+  }
+  {
+    reflexio::record_file<NestedStruct> const file(file_name);
+    REQUIRE(file.size() == records.size() + 1);
+    REQUIRE(file[records.size() - 1] == records.back());
+    REQUIRE(file[records.size()] == records[1]);
+  }
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("reflexio_soa_vector", "[reflexio]") {
+  reflexio::soa_vector<MyStruct> soa;
+  REQUIRE(soa.empty());
+
+  std::vector<MyStruct> records(4);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].var1 = static_cast<int>(i);
+    records[i].var2 = 0.25f * static_cast<float>(i);
+    records[i].var4 = i % 2 == 0;
+    records[i].var5[i] = 1.f;
+    soa.push_back(records[i]);
+  }
+  REQUIRE(soa.size() == records.size());
+
+  std::span<int const> const var1_column = std::as_const(soa).column<&MyStruct::var1>();
+  REQUIRE(var1_column.size() == records.size());
+  REQUIRE(var1_column[3] == 3);
+  std::span<bool> var4_column = soa.column<&MyStruct::var4>();
+  REQUIRE(var4_column[0]);
+  REQUIRE(not var4_column[1]);
+
+  for (size_t i = 0; i < records.size(); i++) {
+    REQUIRE(soa[i] == records[i]);
+    REQUIRE(soa.get(i) == records[i]);
+  }
+
+  soa[1].get<&MyStruct::var2>() = 10.f;
+  REQUIRE(soa.column<&MyStruct::var2>()[1] == 10.f);
+  soa.at(2) = records[0];
+  MyStruct const row2 = soa[2];
+  REQUIRE(row2 == records[0]);
+  REQUIRE_THROWS(soa.at(4));
+
+  soa.pop_back();
+  REQUIRE(soa.size() == 3);
+  soa.resize(5);
+  REQUIRE(soa.back() == MyStruct{});
+
+  reflexio::soa_vector<MyStruct> const soa2{records};
+  REQUIRE(soa2.size() == records.size());
+  REQUIRE(soa2.back() == records.back());
+}
+
+TEST_CASE("reflexio_soa_vector_copy_move", "[reflexio]") {
+  std::vector<MyStruct> records(3);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].var1 = static_cast<int>(i);
+  }
+  reflexio::soa_vector<MyStruct> soa{records};
+
+  reflexio::soa_vector<MyStruct> copy = soa;
+  REQUIRE(copy.size() == records.size());
+  copy[0] = records[2];
+  REQUIRE(soa[0] == records[0]);
+  copy = soa;
+  REQUIRE(copy[0] == records[0]);
+
+  reflexio::soa_vector<MyStruct> moved = std::move(soa);
+  REQUIRE(moved.size() == records.size());
+  REQUIRE(moved.back() == records.back());
+  // the moved-from container is empty and still usable
+  REQUIRE(soa.empty());
+  REQUIRE(soa.column<&MyStruct::var1>().empty());
+  soa.push_back(records[1]);
+  REQUIRE(soa.size() == 1);
+  REQUIRE(soa[0] == records[1]);
+
+  copy = std::move(moved);
+  REQUIRE(copy.size() == records.size());
+  REQUIRE(moved.empty());
+  moved.push_back(records[2]);
+  REQUIRE(moved[0] == records[2]);
+}
+
+// two versions of the same struct: var2 removed, var4 added and declaration order changed
+REFLEXIO_STRUCT_DEFINE(TaggedStructV1,
+  REFLEXIO_MEMBER_VAR_DEFINE(int, var1, 1, "");
+  REFLEXIO_MEMBER_VAR_DEFINE(double, var2, 2., "");
+  REFLEXIO_MEMBER_VAR_DEFINE(uint16_t, var3, 3, "");
+  );
+
+REFLEXIO_STRUCT_DEFINE(TaggedStructV2,
+  REFLEXIO_MEMBER_VAR_DEFINE(uint16_t, var3, 30, "");
+  REFLEXIO_MEMBER_VAR_DEFINE(int, var1, 10, "");
+  REFLEXIO_MEMBER_VAR_DEFINE(float, var4, 40.f, "");
+  );
+
+// var1 retyped with the same size
+REFLEXIO_STRUCT_DEFINE(TaggedStructV3,
+  REFLEXIO_MEMBER_VAR_DEFINE(float, var1, 100.f, "");
+  REFLEXIO_MEMBER_VAR_DEFINE(uint16_t, var3, 300, "");
+  );
+
+TEST_CASE("reflexio_tagged_serialization", "[reflexio]") {
+  // record files reject a retyped member variable too
+  static_assert(reflexio::schema_fingerprint<TaggedStructV1>() != reflexio::schema_fingerprint<TaggedStructV3>());
+
+  std::array<std::byte, 128> buffer{};
+
+  TaggedStructV1 v1;
+  v1.var1 = -5;
+  v1.var2 = 0.5;
+  v1.var3 = 7;
+  size_t const num_bytes = reflexio::to_bytes_tagged(buffer.data(), buffer.size(), v1);
+  REQUIRE(num_bytes == reflexio::serial_size_tagged(v1));
+  REQUIRE(num_bytes == 2 + 3 * 4 + 1 + 3 * 2 + TaggedStructV1::get_serial_size());
+  REQUIRE_THROWS(reflexio::to_bytes_tagged(buffer.data(), num_bytes - 1, v1));
+
+  // same schema
+  TaggedStructV1 v1_copy;
+  REQUIRE(reflexio::from_bytes_tagged(buffer.data(), num_bytes, v1_copy) == num_bytes);
+  REQUIRE(v1_copy == v1);
+
+  // newer reader: unknown var2 gets skipped, var4 is left untouched
+  TaggedStructV2 v2;
+  TaggedStructV2::Mask notUpdated;
+  REQUIRE(reflexio::from_bytes_tagged(buffer.data(), num_bytes, v2, notUpdated) == num_bytes);
+  REQUIRE(v2.var1 == -5);
+  REQUIRE(v2.var3 == 7);
+  REQUIRE(v2.var4 == 40.f);
+  REQUIRE(notUpdated == TaggedStructV2::make_vars_mask<&TaggedStructV2::var3, &TaggedStructV2::var1>());
+
+  // older reader, with a field excluded by the writer
+  v2.var1 = 100;
+  v2.var3 = 300;
+  size_t const v2_num_bytes = reflexio::to_bytes_tagged(buffer.data(), buffer.size(), v2,
+                                                        TaggedStructV2::make_vars_mask<&TaggedStructV2::var3, &TaggedStructV2::var4>());
+  TaggedStructV1 v1_bis;
+  REQUIRE(reflexio::from_bytes_tagged(buffer.data(), v2_num_bytes, v1_bis) == v2_num_bytes);
+  REQUIRE(v1_bis.var1 == 1);
+  REQUIRE(v1_bis.var3 == 300);
+  REQUIRE(v1_bis.var2 == 2.);
+
+  REQUIRE_THROWS(reflexio::from_bytes_tagged(buffer.data(), v2_num_bytes - 1, v1_bis));
+  // truncated anywhere: exactly sized copies, so that reading past the end gets caught by sanitizers
+  for (size_t truncated_size = 0; truncated_size < v2_num_bytes; truncated_size++) {
+    std::vector<std::byte> const truncated(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(truncated_size));
+    REQUIRE_THROWS(reflexio::from_bytes_tagged(truncated.data(), truncated.size(), v1_bis));
+  }
+
+  // retyped member variable of the same size: skipped rather than reinterpreted
+  static_assert(sizeof(TaggedStructV3::var1) == sizeof(TaggedStructV1::var1));
+  static_assert(reflexio::details::tagged_field_id<float>("var1") != reflexio::details::tagged_field_id<int>("var1"));
+  static_assert(reflexio::details::tagged_field_id<TestEnum>("var1") != reflexio::details::tagged_field_id<int>("var1"));
+  static_assert(reflexio::details::tagged_field_id<std::array<int, 2>>("var1") !=
+                reflexio::details::tagged_field_id<std::array<int, 3>>("var1"));
+  static_assert(reflexio::details::tagged_field_id<std::vector<int>>("var1") !=
+                reflexio::details::tagged_field_id<std::string>("var1"));
+  static_assert(reflexio::details::tagged_field_id<MyOtherStruct>("var1") != reflexio::details::tagged_field_id<int>("var1"));
+  size_t const v1_num_bytes = reflexio::to_bytes_tagged(buffer.data(), buffer.size(), v1);
+  TaggedStructV3 v3;
+  TaggedStructV3::Mask v3_not_updated;
+  REQUIRE(reflexio::from_bytes_tagged(buffer.data(), v1_num_bytes, v3, v3_not_updated) == v1_num_bytes);
+  REQUIRE(v3.var1 == 100.f);
+  REQUIRE(v3.var3 == 7);
+  REQUIRE(v3_not_updated == TaggedStructV3::make_vars_mask<&TaggedStructV3::var3>());
+}
+
+TEST_CASE("reflexio_delta_encoding", "[reflexio]") {
+  std::array<std::byte, 128> buffer{};
+  MyStruct const prev{};
+
+  // no change: only the bitmap
+  REQUIRE(reflexio::to_bytes_delta(buffer.data(), buffer.size(), prev, prev) == 1);
+
+  MyStruct cur = prev;
+  cur.var2 = 3.5f;
+  cur.var4 = false;
+  size_t const num_bytes = reflexio::to_bytes_delta(buffer.data(), buffer.size(), prev, cur);
+  REQUIRE(num_bytes == reflexio::serial_size_delta(prev, cur));
+  REQUIRE(num_bytes == 1 + sizeof(float) + 1);
+  REQUIRE_THROWS(reflexio::to_bytes_delta(buffer.data(), num_bytes - 1, prev, cur));
+
+  MyStruct state = prev;
+  REQUIRE(reflexio::apply_delta(std::span{buffer.data(), num_bytes}, state) == num_bytes);
+  REQUIRE(state == cur);
+  REQUIRE_THROWS(reflexio::apply_delta(buffer.data(), num_bytes - 1, state));
+  for (size_t truncated_size = 0; truncated_size < num_bytes; truncated_size++) {
+    std::vector<std::byte> const truncated(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(truncated_size));
+    REQUIRE_THROWS(reflexio::apply_delta(std::span{truncated}, state));
+  }
+}
+
+TEST_CASE("reflexio_batch_serialization", "[reflexio]") {
+  static_assert(not TaggedStructV1::has_packed_layout());
+  static_assert(TaggedStructV1::all_members_memcpy_serializable() == not app_utils::serial::serial_needs_byteswap);
+  static_assert(not MyStruct::all_members_memcpy_serializable());
+
+  // must produce the same bytes as one to_bytes per record
+  auto check_round_trip = [](auto const& records) {
+    using StructT = typename std::remove_cvref_t<decltype(records)>::value_type;
+    size_t const num_bytes = records.size() * StructT::get_serial_size();
+    std::vector<std::byte> buffer(num_bytes);
+    REQUIRE(to_bytes_batch(buffer.data(), buffer.size(), std::span{records}) == num_bytes);
+    REQUIRE_THROWS(to_bytes_batch(buffer.data(), num_bytes - 1, std::span{records}));
+
+    std::vector<std::byte> ref_buffer(num_bytes);
+    size_t offset = 0;
+    for (auto const& record : records) {
+      offset += to_bytes(ref_buffer.data() + offset, ref_buffer.size() - offset, record);
+    }
+    REQUIRE(ref_buffer == buffer);
+
+    std::vector<StructT> received(records.size());
+    REQUIRE(from_bytes_batch(buffer.data(), buffer.size(), std::span{received}) == num_bytes);
+    REQUIRE(received == records);
+    REQUIRE_THROWS(from_bytes_batch(buffer.data(), num_bytes - 1, std::span{received}));
+  };
+
+  std::vector<MyOtherStruct> packed(10);
+  std::vector<TaggedStructV1> padded(10);
+  std::vector<MyStruct> generic(10);
+  for (size_t i = 0; i < 10; i++) {
+    packed[i].var1 = static_cast<int>(i);
+    padded[i].var2 = 0.5 * static_cast<double>(i);
+    padded[i].var3 = static_cast<uint16_t>(i);
+    generic[i].var1 = static_cast<int>(i);
+    generic[i].var4 = i % 3 == 0;
+  }
+  check_round_trip(packed);
+  check_round_trip(padded);
+  check_round_trip(generic);
+}
+
+TEST_CASE("reflexio_stream_decoder", "[reflexio]") {
+  std::vector<MyStruct> records(5);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].var1 = static_cast<int>(i);
+    records[i].var2 = 0.5f * static_cast<float>(i);
+    records[i].var4 = i % 2 == 0;
+    records[i].var5[i] = 2.f;
+  }
+  size_t const record_size = MyStruct::get_serial_size();
+  std::vector<std::byte> buffer(records.size() * record_size);
+  to_bytes_batch(buffer.data(), buffer.size(), std::span{records});
+
+  for (size_t chunk_size : {size_t{1}, size_t{3}, size_t{7}, record_size - 1, record_size + 5, buffer.size()}) {
+    reflexio::stream_decoder<MyStruct> decoder;
+    std::vector<MyStruct> decoded;
+    for (size_t offset = 0; offset < buffer.size(); offset += chunk_size) {
+      auto const chunk = std::span{buffer}.subspan(offset, std::min(chunk_size, buffer.size() - offset));
+      decoder.feed(chunk, [&](MyStruct const& record) { decoded.push_back(record); });
+      REQUIRE(decoder.num_pending_bytes() == (offset + chunk.size()) % record_size);
+    }
+    REQUIRE(not decoder.has_partial_record());
+    REQUIRE(decoded == records);
+  }
+
+  reflexio::stream_decoder<MyStruct> decoder;
+  REQUIRE(decoder.feed(std::span{buffer}.first(record_size + 2), [](MyStruct const&) {}) == 1);
+  REQUIRE(decoder.has_partial_record());
+  decoder.reset();
+  REQUIRE(decoder.num_pending_bytes() == 0);
+}
+
 TEST_CASE("reflexio_yaml_sections", "[reflexio]") {
 
   for (int i = 0; i <= 1; i++) {
@@ -379,6 +869,41 @@ TEST_CASE("reflexio_yaml_sections", "[reflexio]") {
   }
 }
 
+TEST_CASE("reflexio_yaml_writer", "[reflexio]") {
+  // must produce the same text as the ostream based emitter
+  auto const check = [](auto const& obj, auto const& excludeMask) {
+    using StructT = std::remove_cvref_t<decltype(obj)>;
+    std::ostringstream oss;
+    to_yaml(typename StructT::ConstView{obj, excludeMask}, oss);
+    std::string out = "header\n";
+    to_yaml(typename StructT::ConstView{obj, excludeMask}, out);
+    REQUIRE(out == "header\n" + oss.str());
+  };
+
+  FancierStruct fancier;
+  fancier.var2 = 1.f / 3.f;
+  fancier.var6[1] = 1e-7f;
+  fancier.var6[2] = 123456789.f;
+  fancier.var6[3] = -0.f;
+  fancier.var3 = MyEnum::EnumVal1;
+  check(fancier, FancierStruct::exclude_none);
+  check(fancier, FancierStruct::make_vars_mask<&FancierStruct::var2, &FancierStruct::var6>());
+
+  NestedStruct nested;
+  nested.struct1.var1 = -42;
+  nested.struct2.var2 = 2.5e10f;
+  check(nested, NestedStruct::exclude_none);
+
+  // the output buffer is reusable
+  std::string out;
+  to_yaml(NestedStruct::ConstView{nested}, out);
+  size_t const capacity = out.capacity();
+  out.clear();
+  to_yaml(NestedStruct::ConstView{nested}, out);
+  REQUIRE(out.capacity() == capacity);
+  REQUIRE(out == to_yaml(nested));
+}
+
 TEST_CASE("reflexio_yaml_io", "[reflexio]") {
 
     FancierStruct myStruct_in;
@@ -400,6 +925,44 @@ TEST_CASE("reflexio_yaml_io", "[reflexio]") {
     REQUIRE(myStruct_in == myStruct_out);
 }
 
+TEST_CASE("reflexio_yaml_parser", "[reflexio]") {
+  FancierStruct fancier;
+  fancier.var1 = -256;
+  fancier.var2 = 1.f / 3.f;
+  fancier.var3 = MyEnum::EnumVal1;
+  fancier.var6 = {1, 2, 3, 4, 5, 6, 7, 8};
+  FancierStruct fancier2;
+  from_yaml(fancier2, std::string_view{to_yaml(fancier)});
+  REQUIRE(fancier == fancier2);
+
+  // nested structs, sections, comments and skipped member variables, in a single pass over the text
+  NestedStruct nested;
+  nested.struct1.var1 = -42;
+  nested.struct2.var2 = 2.5e10f;
+  TrivialStruct trivial;
+  trivial.var1 = 7;
+  trivial.var2 = 7.5f;
+  std::string const text = "# comment\n---\n" + to_yaml(nested) + "...\n\n---\n" + to_yaml(trivial) + "---\n";
+  yaml_utils::yaml_reader reader(text);
+  NestedStruct nested2;
+  from_yaml(nested2, reader);
+  REQUIRE(nested == nested2);
+  TrivialStruct trivial2;
+  from_yaml(trivial2, reader, TrivialStruct::make_vars_mask<&TrivialStruct::var1>());
+  REQUIRE(trivial2.var1 == trivial.var1);
+  REQUIRE(trivial2.var2 == TrivialStruct{}.var2);
+  REQUIRE(reader.at_end());
+
+  nested2 = {};
+  from_yaml(nested2, std::string_view{to_yaml(nested)}, NestedStruct::make_vars_mask<&NestedStruct::struct2>());
+  REQUIRE(nested2.struct2 == nested.struct2);
+  REQUIRE(nested2.struct1 == MyOtherStruct{});
+
+  REQUIRE_THROWS(from_yaml(trivial2, std::string_view{"var1: 1\nunknown: 2\n"}));
+  REQUIRE_THROWS(from_yaml(trivial2, std::string_view{"var1: 1x\n"}));
+  REQUIRE_THROWS(from_yaml(fancier2, std::string_view{"var6: [1, 2]\n"}));
+}
+
 TEST_CASE("reflexio_view_serialization", "[reflexio]") {
 
   auto excludeMask = FancierStruct::make_vars_mask(&FancierStruct::var2,
@@ -43,6 +43,12 @@ static_assert(std::is_trivially_copy_assignable_v<TrivialStruct>);
 static_assert(std::is_trivially_copy_constructible_v<TrivialStruct>);
 //static_assert(std::is_trivially_constructible_v<TrivialStruct>); // NO: because of in-line initialization
 
+static_assert(MyOtherStruct::has_packed_layout() or app_utils::serial::serial_needs_byteswap);
+static_assert(not TrivialStruct::has_packed_layout()); // padding between var1 and var2
+static_assert(app_utils::serial::fixed_serial_size_v<TestEnum> == 1);
+static_assert(app_utils::serial::fixed_serial_size_v<MyOtherStruct> == 8);
+static_assert(app_utils::serial::fixed_serial_size_v<TrivialStruct> == TrivialStruct::get_serial_size());
+
 REFLEXIO_STRUCT_DEFINE(NestedStruct,
   REFLEXIO_MEMBER_VAR_DEFINE(int, field_top, 22, "var1 doc");
   REFLEXIO_MEMBER_VAR_DEFINE(MyOtherStruct, struct1, {}, "var2 doc");
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <app_utils/rolling_window.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+
+TEST_CASE("rolling_window", "[container]") {
+  using min_t = rolling_min_t<int>;
+  using max_t = rolling_max_t<int>;
+  rolling_window_t<int, rolling_sum_t<long>, rolling_mean_variance_t, min_t, max_t> window(7);
+  REQUIRE(window.capacity() == 7);
+  REQUIRE(window.empty());
+  REQUIRE_THROWS(window.get<min_t>().value());
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-20, 20);
+  for (int i = 0; i < 200; i++) {
+    if (i % 17 == 16) {
+      window.pop_front(3);
+    } else {
+      window.push_back(dist(gen));
+    }
+    // compared with a full rescan of the window
+    std::vector<int> values(window.values().begin(), window.values().end());
+    REQUIRE(values.size() == window.size());
+    if (values.empty()) {
+      continue;
+    }
+    long const sum = std::accumulate(values.begin(), values.end(), 0L);
+    double const mean = double(sum) / double(values.size());
+    double sum_sq = 0.;
+    for (int val : values) {
+      sum_sq += (val - mean) * (val - mean);
+    }
+    REQUIRE(window.get<0>().value() == sum);
+    auto const& mean_variance = window.get<rolling_mean_variance_t>();
+    REQUIRE(mean_variance.count() == values.size());
+    REQUIRE(std::abs(mean_variance.mean() - mean) < 1e-9);
+    REQUIRE(std::abs(mean_variance.variance() - sum_sq / double(values.size())) < 1e-9);
+    REQUIRE(window.get<min_t>().value() == *std::min_element(values.begin(), values.end()));
+    REQUIRE(window.get<max_t>().value() == *std::max_element(values.begin(), values.end()));
+  }
+
+  window.clear();
+  REQUIRE(window.empty());
+  REQUIRE(window.get<0>().value() == 0);
+  REQUIRE(window.get<rolling_mean_variance_t>().count() == 0);
+}
+
+TEST_CASE("rolling_window_custom_aggregator", "[container]") {
+  // string concatenation: associative but neither commutative nor invertible
+  auto const concat = [](std::string const& a, std::string const& b) { return a + b; };
+  using concat_t = rolling_aggregate_t<std::string, decltype(concat)>;
+  rolling_window_t<std::string, concat_t> window(3, concat_t{concat});
+
+  std::string all;
+  for (char c = 'a'; c <= 'k'; c++) {
+    window.push_back(std::string(1, c));
+    all += c;
+    REQUIRE(window.get<concat_t>().value() == all.substr(all.size() - std::min<size_t>(all.size(), 3)));
+  }
+  window.pop_front();
+  REQUIRE(window.get<concat_t>().value() == "jk");
+  window.push_back("l");
+  REQUIRE(window.get<concat_t>().value() == "jkl");
+  window.pop_front(3);
+  REQUIRE(window.empty());
+  REQUIRE_THROWS(window.get<concat_t>().value());
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <app_utils/serial_utils.hpp>
+#include <app_utils/serial_buffer_pool.hpp>
+
+TEST_CASE("buffer_pool_size_classes", "[serial]") {
+  using app_utils::serial::buffer_pool;
+  static_assert(buffer_pool::size_class(0) == 0);
+  static_assert(buffer_pool::size_class(64) == 0);
+  static_assert(buffer_pool::size_class(65) == 1);
+  static_assert(buffer_pool::size_class(128) == 1);
+  static_assert(buffer_pool::size_class(size_t{1} << 40) == buffer_pool::num_size_classes);
+  static_assert(buffer_pool::size_class_capacity(1) == 128);
+}
+
+TEST_CASE("buffer_pool_reuse", "[serial]") {
+  using namespace app_utils::serial;
+  buffer_pool pool;
+
+  uint32_t const val1 = 12;
+  std::string const val2 = "echo";
+  std::byte const* first_data = nullptr;
+  {
+    pooled_buffer buffer = make_buffer(pool, val1, val2);
+    REQUIRE(buffer.size() == 9);
+    REQUIRE(buffer.capacity() == 64);
+    REQUIRE(buffer.bytes() == make_buffer(val1, val2));
+    first_data = buffer.data();
+    REQUIRE(pool.num_free_buffers() == 0);
+  }
+  REQUIRE(pool.num_free_buffers() == 1);
+
+  // same size class: the released buffer gets reused
+  pooled_buffer buffer = make_buffer(pool, val2);
+  REQUIRE(buffer.data() == first_data);
+  REQUIRE(pool.num_free_buffers() == 0);
+
+  // growing past the size class capacity swaps for a bigger pooled buffer
+  std::string const long_str(100, 'a');
+  append_to_buffer(buffer, long_str, val1);
+  REQUIRE(buffer.size() == 5 + 101 + 4);
+  REQUIRE(buffer.capacity() == 128);
+  REQUIRE(pool.num_free_buffers() == 1);
+
+  std::string str1, str2;
+  uint32_t val3 = 0;
+  from_bytes(std::span<std::byte const>(buffer), str1);
+  from_bytes(buffer.data() + 5, buffer.size() - 5, str2, val3);
+  REQUIRE(str1 == val2);
+  REQUIRE(str2 == long_str);
+  REQUIRE(val3 == val1);
+
+  pooled_buffer moved = std::move(buffer);
+  moved = pooled_buffer{};
+  REQUIRE(pool.num_free_buffers() == 2);
+}
+
+TEST_CASE("buffer_pool_lifetime", "[serial]") {
+  using namespace app_utils::serial;
+  // a buffer may outlive the pool it came from
+  pooled_buffer buffer = [] {
+    buffer_pool pool;
+    return make_buffer(pool, uint32_t{42});
+  }();
+  REQUIRE(buffer.size() == 4);
+  buffer.resize(1000);
+  REQUIRE(buffer.size() == 1000);
+  uint32_t val = 0;
+  from_bytes(buffer.data(), buffer.size(), val);
+  REQUIRE(val == 42);
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <app_utils/serial_utils.hpp>
+#include <app_utils/serial_iovec.hpp>
 #include <complex>
 
 TEST_CASE("string_to_from_bytes", "[serial]") {
@@ -125,3 +126,257 @@ TEST_CASE("bitset_to_from_bytes", "[serial]") {
     }
   }
 }
+
+TEST_CASE("varint_to_from_bytes", "[serial]") {
+  using namespace app_utils::serial;
+  static_assert(varint_size(0) == 1);
+  static_assert(varint_size(127) == 1);
+  static_assert(varint_size(128) == 2);
+  static_assert(varint_size(UINT64_MAX) == 10);
+  static_assert(zigzag_decode(zigzag_encode(-3)) == -3);
+  static_assert(zigzag_encode(-1) == 1);
+
+  std::vector<std::byte> buffer(16);
+  for (int64_t val : {int64_t{0}, int64_t{-1}, int64_t{63}, int64_t{-64}, int64_t{300}, INT64_MIN, INT64_MAX}) {
+    varint<int64_t> const u = val;
+    size_t const num_bytes_written = to_bytes(buffer, u);
+    REQUIRE(num_bytes_written == serial_size(u));
+    varint<int64_t> v;
+    REQUIRE(from_bytes(buffer, v) == num_bytes_written);
+    REQUIRE(v == u);
+  }
+  REQUIRE(serial_size(varint<uint32_t>{5}) == 1);
+  REQUIRE(serial_size(varint<int32_t>{-5}) == 1);
+
+  // truncated varint
+  varint<uint32_t> const large = 1u << 20;
+  to_bytes(buffer, large);
+  varint<uint32_t> v;
+  REQUIRE_THROWS(from_bytes({buffer.data(), 2}, v));
+
+  // 10 bytes varints: the last byte only holds the 64th bit
+  std::array<std::byte, 11> max_buffer{};
+  std::fill_n(max_buffer.begin(), 9, std::byte{0xFF});
+  max_buffer[9] = std::byte{0x01};
+  uint64_t decoded = 0;
+  REQUIRE(from_varint(max_buffer.data(), max_buffer.size(), decoded) == 10);
+  REQUIRE(decoded == UINT64_MAX);
+  max_buffer[9] = std::byte{0x02};  // overflow
+  REQUIRE(from_varint(max_buffer.data(), max_buffer.size(), decoded) == 0);
+  max_buffer[9] = std::byte{0x81};  // continued past 10 bytes
+  REQUIRE(from_varint(max_buffer.data(), max_buffer.size(), decoded) == 0);
+  varint<uint64_t> v64;
+  REQUIRE_THROWS(from_bytes(max_buffer, v64));
+  REQUIRE(try_from_bytes(max_buffer.data(), max_buffer.size(), v64).error == serial_error::invalid_data);
+}
+
+TEST_CASE("varint_sized_to_from_bytes", "[serial]") {
+  using namespace app_utils::serial;
+  std::vector<std::byte> buffer;
+
+  varint_sized<std::string> const str(300, 'a');
+  REQUIRE(serial_size(str) == 2 + 300);
+  REQUIRE(to_bytes(buffer, str) == 302);
+  varint_sized<std::string> str2;
+  REQUIRE(from_bytes(buffer, str2) == 302);
+  REQUIRE(str2 == str);
+
+  varint_sized<std::vector<uint16_t>> vect(1000);
+  vect[999] = 42;
+  REQUIRE(serial_size(vect) == 2 + 2000);
+  to_bytes(buffer, vect);
+  varint_sized<std::vector<uint16_t>> vect2;
+  REQUIRE(from_bytes(buffer, vect2) == 2002);
+  REQUIRE(vect2 == vect);
+  REQUIRE_THROWS(from_bytes({buffer.data(), 100}, vect2));
+
+  // small sizes are wire compatible with the 1 byte size prefix
+  std::string const small_str = "echo";
+  REQUIRE(to_bytes(buffer, small_str) == 5);
+  REQUIRE(from_bytes(buffer, str2) == 5);
+  REQUIRE(str2 == small_str);
+
+  // the 1 byte size prefix refuses to truncate
+  std::vector<std::byte> large_buffer(400);
+  REQUIRE_THROWS(to_bytes(large_buffer.data(), large_buffer.size(), std::string(300, 'a')));
+}
+
+TEST_CASE("checked_to_from_bytes", "[serial]") {
+  using namespace app_utils::serial;
+  std::array<std::byte, 16> buffer{};
+
+  uint32_t const u = 0xABCD;
+  std::string const str = "echo";
+  auto res = try_to_bytes(buffer.data(), buffer.size(), u, str);
+  REQUIRE(res);
+  REQUIRE(*res == 4 + 5);
+  REQUIRE(try_to_bytes(buffer.data(), 8, u, str) == serial_result{0, serial_error::buffer_too_small});
+  REQUIRE(try_to_bytes(buffer.data(), 3, u).error == serial_error::buffer_too_small);
+  REQUIRE(try_to_bytes(buffer.data(), buffer.size(), std::string(300, 'a')).error == serial_error::invalid_data);
+
+  uint32_t v = 0;
+  std::string str2;
+  res = try_from_bytes(buffer.data(), 9, v, str2);
+  REQUIRE(res);
+  REQUIRE(*res == 9);
+  REQUIRE(v == u);
+  REQUIRE(str2 == str);
+
+  // truncated packets
+  for (size_t len = 0; len < 9; len++) {
+    REQUIRE(try_from_bytes(buffer.data(), len, v, str2).error == serial_error::truncated_data);
+  }
+
+  std::vector<uint16_t> const vect{1, 2, 3};
+  REQUIRE(*try_to_bytes(buffer.data(), buffer.size(), vect) == 7);
+  std::vector<uint16_t> vect2;
+  REQUIRE(try_from_bytes(buffer.data(), 6, vect2).error == serial_error::truncated_data);
+  REQUIRE(*try_from_bytes(std::span{buffer.data(), 7}, vect2) == 7);
+  REQUIRE(vect2 == vect);
+
+  varint<uint64_t> const large = UINT64_MAX;
+  REQUIRE(*try_to_bytes(buffer.data(), buffer.size(), large) == 10);
+  varint<uint64_t> large2;
+  REQUIRE(try_from_bytes(buffer.data(), 9, large2).error == serial_error::truncated_data);
+  REQUIRE(*try_from_bytes(buffer.data(), 10, large2) == 10);
+  REQUIRE(large2 == large);
+
+  // corrupt size prefixes get rejected before allocating
+  std::vector<uint16_t> vect3{9};
+  buffer[0] = std::byte{0xFF};
+  REQUIRE(try_from_bytes(buffer.data(), 7, vect3).error == serial_error::truncated_data);
+  REQUIRE(vect3 == std::vector<uint16_t>{9});
+  varint_sized<std::vector<uint32_t>> huge;
+  REQUIRE(*try_to_bytes(buffer.data(), buffer.size(), varint<uint64_t>{uint64_t{1} << 60}) == 9);
+  REQUIRE(try_from_bytes(buffer.data(), buffer.size(), huge).error == serial_error::truncated_data);
+  varint_sized<std::string> huge_str;
+  REQUIRE(try_from_bytes(buffer.data(), buffer.size(), huge_str).error == serial_error::truncated_data);
+  REQUIRE(huge_str.empty());
+}
+
+TEST_CASE("iovec_sink", "[serial]") {
+  using namespace app_utils::serial;
+  uint32_t const header = 42;
+  std::string const blob(200, 'b');
+  std::array<double, 16> values{};
+  values[3] = 1.5;
+  std::string_view const small = "abc";
+  std::vector<uint16_t> const samples(100, 7);
+
+  iovec_sink sink;
+  sink.append(header, blob, values);
+  sink.append(small, samples, uint8_t{1});
+
+  std::vector<std::byte> expected(serial_size(header) + serial_size(blob) + serial_size(values) +
+                                  serial_size(small) + serial_size(samples) + 1);
+  REQUIRE(to_bytes(expected.data(), expected.size(), header, blob, values, small, samples, uint8_t{1}) == expected.size());
+  REQUIRE(sink.size() == expected.size());
+
+  auto const iovecs = sink.iovecs();
+  if constexpr (not serial_needs_byteswap) {
+    // header + blob size | blob | values | small + samples size | samples | trailing byte
+    REQUIRE(iovecs.size() == 6);
+    REQUIRE(iovecs[1].iov_base == blob.data());
+    REQUIRE(iovecs[2].iov_base == values.data());
+    REQUIRE(iovecs[4].iov_base == samples.data());
+  } else {
+    // multi-byte values get byte swapped copies: header + blob size | blob | the rest
+    REQUIRE(iovecs.size() == 3);
+    REQUIRE(iovecs[1].iov_base == blob.data());
+  }
+
+  std::vector<std::byte> gathered(sink.size());
+  REQUIRE(sink.copy_to(gathered.data(), gathered.size()) == gathered.size());
+  REQUIRE(gathered == expected);
+
+  sink.clear();
+  REQUIRE(sink.empty());
+  REQUIRE(sink.iovecs().empty());
+}
+
+TEST_CASE("fixed_serial_size", "[serial]") {
+  using namespace app_utils::serial;
+  static_assert(is_fixed_serial_size<uint32_t>::value);
+  static_assert(is_fixed_serial_size<std::array<uint16_t, 5>>::value);
+  static_assert(is_fixed_serial_size<std::bitset<10>>::value);
+  static_assert(not is_fixed_serial_size<std::string>::value);
+  static_assert(not is_fixed_serial_size<std::vector<int>>::value);
+  static_assert(not is_fixed_serial_size<varint<int>>::value);
+  static_assert(fixed_serial_size_v<std::array<uint16_t, 5>> == 10);
+  static_assert(fixed_serial_size_v<std::bitset<10>> == 2);
+  static_assert(std::tuple_size_v<static_buffer_t<uint32_t, std::bitset<10>, double>> == 4 + 2 + 8);
+
+  std::bitset<10> bits;
+  bits.set(9);
+  auto const buffer = make_static_buffer(uint32_t{7}, bits);
+  static_assert(std::is_same_v<decltype(buffer), std::array<std::byte, 6> const>);
+  uint32_t val = 0;
+  std::bitset<10> bits2;
+  REQUIRE(from_bytes(buffer.data(), buffer.size(), val, bits2) == 6);
+  REQUIRE(val == 7);
+  REQUIRE(bits2 == bits);
+}
+
+TEST_CASE("bitset_word_serialization", "[serial]") {
+  using namespace app_utils::serial;
+  // reference: bit i in byte i/8, little-endian bit order
+  auto check = []<size_t N>(std::bitset<N> const& bits) {
+    std::vector<std::byte> expected(serial_size(bits));
+    for (size_t i = 0; i < N; i++) {
+      if (bits.test(i)) {
+        expected[i / 8] |= std::byte(1 << i % 8);
+      }
+    }
+    std::vector<std::byte> buffer(expected.size());
+    REQUIRE(to_bytes(buffer.data(), buffer.size(), bits) == expected.size());
+    REQUIRE(buffer == expected);
+
+    std::bitset<N> bits2;
+    bits2.set();
+    REQUIRE(from_bytes(buffer.data(), buffer.size(), bits2) == expected.size());
+    REQUIRE(bits2 == bits);
+  };
+
+  std::bitset<512> mask;
+  for (size_t i = 0; i < mask.size(); i += 7) {
+    mask.set(i);
+  }
+  check(mask);
+  std::bitset<77> odd_size;
+  odd_size.set(0).set(63).set(64).set(76);
+  check(odd_size);
+  check(std::bitset<3>(5));
+
+  // bits beyond N in the serialized data are ignored
+  std::array<std::byte, 2> const bytes{std::byte{0xFF}, std::byte{0xFF}};
+  std::bitset<10> bits;
+  from_bytes(bytes.data(), bytes.size(), bits);
+  REQUIRE(bits.all());
+  REQUIRE(bits.count() == 10);
+  REQUIRE((bits << 1).count() == 9);
+}
+
+TEST_CASE("serial_byte_order", "[serial]") {
+  using namespace app_utils::serial;
+  static_assert(byteswap(uint16_t{0x1234}) == 0x3412);
+  static_assert(byteswap(int32_t{0x12345678}) == 0x78563412);
+  static_assert(byteswap(byteswap(1.5)) == 1.5);
+  static_assert(byteswap(uint8_t{7}) == 7);
+
+  std::array<std::byte, 4> buffer{};
+  to_bytes(buffer.data(), buffer.size(), uint32_t{0x01020304});
+  if constexpr (serial_byte_order == std::endian::little) {
+    REQUIRE(buffer == std::array{std::byte{4}, std::byte{3}, std::byte{2}, std::byte{1}});
+  } else {
+    REQUIRE(buffer == std::array{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}});
+  }
+
+  // bulk swap
+  std::array<uint32_t, 5> const values{1, 2, 3, 0x01020304, 0xFFFF0000};
+  std::array<std::byte, 20> swapped{};
+  byteswap_copy(swapped.data(), values.data(), values.size());
+  std::array<uint32_t, 5> values2{};
+  byteswap_copy(values2.data(), swapped.data(), values2.size());
+  REQUIRE(values2 == values);
+  REQUIRE(swapped[3] == std::byte{1});
+}
@@ -0,0 +1,10 @@
+
+/* AUTOMATICALLY GENERATED - DO NOT COMMIT, DO NOT EDIT AS IT WILL BE OVERWRITTEN */
+#include "version.h"
+
+namespace version {
+std::string_view git_rev() { return "d8dc623"; }
+std::string_view git_tag() { return ""; }
+std::string_view git_branch() { return "master"; }
+std::string_view compilation_timestamp() { return __DATE__ ":" __TIME__; }
+}
\ No newline at end of file